@@ -0,0 +1,127 @@
+#ifndef BANCO_DADOS_H
+#define BANCO_DADOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "EDL.h"
+#include "FiltroBloom.h"
+#include "IndiceSecundario.h"
+#include "abb/ABB.h"
+#include "persistencia/DiarioEscrita.h"
+
+// Base durável: EDL + ABB em memória, com as alterações protegidas por um diário de
+// escrita antecipada (persistencia/DiarioEscrita.h) e por checkpoints periódicos.
+//
+// Arquivos no diretório da base:
+//   * "base.chk": checkpoint, com a EDL e o índice completos e o número da última
+//     operação do diário que ele já inclui;
+//   * "base.wal": diário com as operações feitas depois do checkpoint.
+// Ao abrir, o checkpoint é carregado e as operações do diário com número maior que o dele
+// são reaplicadas, então EDL e índice voltam sempre ao mesmo estado lógico, mesmo que o
+// programa tenha caído entre a alteração da EDL e a do índice.
+//
+// Cada inserção/remoção é registrada no diário antes de alterar a EDL e o índice, e é
+// confirmada (gravada e sincronizada com o disco) a cada 'operacoesPorGrupo' operações.
+// Com 1, toda operação é durável ao retornar; com valores maiores, o custo da sincronização
+// é dividido pelo grupo, e uma queda perde no máximo as operações do grupo em aberto.
+//
+// Além do índice de CPFs, a base mantém índices secundários de nome e de data de nascimento
+// (IndiceSecundario.h), atualizados em toda inserção, remoção e compactação. Eles não são
+// gravados no checkpoint: são reconstruídos a partir da EDL ao abrir a base.
+//
+// Opcionalmente, um filtro de Bloom (FiltroBloom.h) com os CPFs do índice fica na frente
+// das buscas por CPF: na inserção de um CPF novo, na remoção e em buscarPosicao, um CPF
+// que certamente não está na base é respondido sem descer a árvore. O filtro é refeito a
+// partir do índice ao abrir a base, a cada checkpoint (o que descarta os CPFs removidos)
+// e quando o número de CPFs passa da capacidade dele (que então dobra).
+// Requer um sistema POSIX. Não é seguro para uso simultâneo por várias threads.
+class BancoDados {
+public:
+    // Abre a base em 'diretorio' (criando-o se não existir) e recupera o estado salvo.
+    // 'taxaFalsosPositivos' em (0, 1) liga o filtro de CPFs com essa taxa; 0 o desliga.
+    // Lança std::runtime_error se os arquivos não puderem ser abertos ou se o checkpoint
+    // estiver corrompido, e std::invalid_argument para uma taxa fora de [0, 1).
+    explicit BancoDados(const std::string& diretorio, size_t operacoesPorGrupo = 1,
+                        double taxaFalsosPositivos = 0);
+
+    // Confirma as operações do grupo em aberto.
+    ~BancoDados() = default;
+
+    BancoDados(const BancoDados&) = delete;
+    BancoDados& operator=(const BancoDados&) = delete;
+
+    // Insere o registro e indexa seu CPF. Retorna a posição na EDL, ou -1 (sem registrar
+    // nada no diário) se o CPF já estiver no índice.
+    // Lança std::invalid_argument se o CPF for inválido.
+    int inserir(const Registro& registro);
+
+    // Remove o registro do CPF (índice e EDL). Retorna false se o CPF não estiver no índice.
+    bool remover(const ChaveCPF& cpf);
+
+    // Confirma imediatamente as operações do grupo em aberto.
+    void confirmar();
+
+    // Grava um checkpoint e esvazia o diário. A EDL é compactada antes, então o checkpoint
+    // não guarda buracos. O novo checkpoint é gravado em um arquivo temporário e só então
+    // renomeado sobre o antigo: uma queda no meio mantém o checkpoint anterior e o diário.
+    void checkpoint();
+
+    // Posição na EDL do registro com o CPF, ou -1 se não houver.
+    int buscarPosicao(const ChaveCPF& cpf) const;
+
+    // Consultas pelos índices secundários, sem percorrer a EDL: O(log n + k).
+    // Retornam as posições na EDL dos registros encontrados.
+    std::vector<int> buscarPorNome(const std::string& nome) const;
+    std::vector<int> buscarPorDataNascimento(const std::string& data) const;
+
+    // Registros nascidos entre 'inicio' e 'fim' (datas "dd/mm/aaaa", inclusive),
+    // em ordem cronológica.
+    std::vector<int> buscarPorNascimentoEntre(const std::string& inicio, const std::string& fim) const;
+
+    const EDL& getRegistros() const { return registros; }
+    const ABB& getIndice() const { return indice; }
+    const IndiceNome& getIndiceNome() const { return indiceNome; }
+    const IndiceDataNascimento& getIndiceNascimento() const { return indiceNascimento; }
+    const FiltroBloom& getFiltroCPF() const { return filtroCPF; }
+    const DiarioEscrita& getDiario() const { return diario; }
+
+    // Operações do diário reaplicadas ao abrir a base.
+    size_t getOperacoesReaplicadas() const { return operacoesReaplicadas; }
+
+private:
+    std::string diretorio;
+    std::string caminhoCheckpoint;
+    EDL registros;
+    ABB indice;
+    IndiceNome indiceNome;
+    IndiceDataNascimento indiceNascimento;
+    double taxaFiltro;           // 0: sem filtro de CPFs
+    FiltroBloom filtroCPF;
+    uint64_t numeroCheckpoint;   // Última operação do diário incluída no checkpoint
+    DiarioEscrita diario;
+    size_t operacoesPorGrupo;
+    size_t operacoesReaplicadas;
+
+    // Posição do CPF no índice, consultando antes o filtro (se houver).
+    int localizarCPF(const ChaveCPF& cpf) const;
+
+    // Refaz o filtro com os CPFs do índice, com capacidade para o dobro deles.
+    void reconstruirFiltro();
+
+    // Alterações em memória, usadas tanto pelas operações novas quanto pela reaplicação.
+    int aplicarInsercao(const Registro& registro, const ChaveCPF& cpf);
+    bool aplicarRemocao(const ChaveCPF& cpf);
+
+    // Confirma o grupo se ele estiver completo.
+    void fecharGrupo();
+
+    // Compacta a EDL por completo, corrigindo as posições em todos os índices.
+    void compactarRegistros();
+
+    // Carrega EDL e índice do checkpoint, se ele existir, e reconstrói os índices secundários.
+    void carregarCheckpoint();
+};
+
+#endif // BANCO_DADOS_H
@@ -0,0 +1,59 @@
+#ifndef BASE_CONCORRENTE_H
+#define BASE_CONCORRENTE_H
+
+#include "EDL.h"
+#include "abb/ABB.h"
+#include "concorrencia/LeftRight.h"
+
+// "Arquivo de registros" (EDL) e "arquivo de índices" (ABB) mantidos juntos.
+struct BaseDados {
+    EDL registros;
+    ABB indice;
+
+    BaseDados() : indice(TipoBalanceamento::AVL) {}
+};
+
+// Modo concorrente da base: várias threads podem consultar ao mesmo tempo em que
+// uma thread insere ou remove registros, e as consultas nunca bloqueiam.
+// A EDL e a ABB ficam sob um controle Left-Right (concorrencia/LeftRight.h): as leituras
+// usam uma cópia estável enquanto a escrita é aplicada na outra, ao custo de manter
+// duas cópias da base em memória e de aplicar cada escrita duas vezes.
+// Escritas concorrentes são permitidas, mas executam uma de cada vez.
+class BaseConcorrente {
+private:
+    LeftRight<BaseDados> base;
+
+public:
+    BaseConcorrente();
+
+    // Insere o registro na EDL e seu CPF no índice, de forma atômica para os leitores.
+    // Retorna a posição na EDL, ou -1 (sem alterar nada) se o CPF já estiver no índice.
+    int inserir(const Registro& registro);
+
+    // Marca o registro do CPF como deletado na EDL (liberando a posição para reuso)
+    // e remove o CPF do índice. Retorna false se o CPF não estiver no índice.
+    bool remover(const ChaveCPF& cpf);
+
+    // Executa até 'maxPassos' passos da compactação da EDL (veja compactarEDL).
+    // Retorna true se ainda houver buracos a fechar.
+    bool compactar(size_t maxPassos);
+
+    // Posição na EDL do registro com o CPF, ou -1 se não houver.
+    int buscarPosicao(const ChaveCPF& cpf) const;
+
+    // Copia para 'resultado' o registro com o CPF (busca no índice + leitura na EDL,
+    // vistas no mesmo estado da base). Retorna false se o CPF não estiver no índice.
+    bool buscarRegistro(const ChaveCPF& cpf, Registro& resultado) const;
+
+    // Número de CPFs no índice.
+    size_t getTamanho() const;
+
+    // Consulta arbitrária sobre um estado consistente da base (ex.: busca em lote).
+    // Referências para dentro da base não devem escapar de 'ler'.
+    template <typename Leitura>
+    auto ler(Leitura ler) const -> decltype(ler(std::declval<const BaseDados&>())) {
+        return base.ler(ler);
+    }
+};
+
+#endif // BASE_CONCORRENTE_H
@@ -1,32 +1,74 @@
 #ifndef EDL_H
 #define EDL_H
 
+#include <functional> // Para std::function (aviso de registros movidos)
+#include <queue>      // Para a fila de prioridade das posições livres
 #include <vector>
 #include "Registro.h" // Inclui a definição da classe Registro
 
 // Classe que simula uma Estrutura de Dados Linear (EDL), ou "arquivo de registros".
 // Armazena objetos Registro completos em um vetor.
+// As posições de registros removidos com 'removerRegistro' são reaproveitadas pelas
+// próximas inserções, e 'compactar' fecha os buracos restantes aos poucos.
 class EDL {
+public:
+    // Chamada quando a compactação move um registro: quem guarda posições da EDL
+    // (como a ABB de índices) deve trocar 'posicaoAntiga' por 'posicaoNova'.
+    typedef std::function<void(const Registro& registro, int posicaoAntiga, int posicaoNova)> AoMoverRegistro;
+
 private:
     std::vector<Registro> dados; // O "array de registros" em memória principal
 
+    // Posições livres (registros removidos), com a menor no topo: as inserções preenchem
+    // primeiro o início da EDL, e a compactação fecha os buracos do início para o fim.
+    // Entradas cuja posição já saiu da lista (naListaLivre falso) são descartadas ao chegar ao topo.
+    std::priority_queue<int, std::vector<int>, std::greater<int> > posicoesLivres;
+    std::vector<bool> naListaLivre; // naListaLivre[i]: a posição i está livre para reuso
+    size_t quantidadeLivres;
+
+    // Descarta do topo da fila as posições que não estão mais livres.
+    void descartarLivresInvalidas();
+
 public:
     // Construtor padrão.
     EDL();
 
+    // Cria a EDL com os registros do vetor, nas mesmas posições, sem copiá-los um a um.
+    // Registros já deletados no vetor não entram na lista de posições livres.
+    explicit EDL(std::vector<Registro> registros);
+
     // Busca um Registro pela sua posição (índice) no vetor.
     // Retorna uma referência CONSTANTE ao Registro.
     // Lança std::out_of_range se o índice for inválido.
     const Registro& buscarPorPosicao(int indice) const;
 
-    // Insere um novo Registro no final da EDL.
+    // Insere um novo Registro na EDL, reaproveitando a menor posição livre (se houver)
+    // ou, caso contrário, no final.
     // Retorna a posição (índice) onde o Registro foi gravado.
-    // Tem complexidade O(1) amortizada para std::vector.
+    // Tem complexidade O(log L) para L posições livres, ou O(1) amortizada sem posições livres.
     int inserirRegistro(const Registro& novoRegistro);
 
+    // Remove logicamente o Registro: marca-o como deletado e guarda a posição para reuso.
+    // Não faz nada se o registro já estiver deletado.
+    // Lança std::out_of_range se o índice for inválido.
+    void removerRegistro(int indice);
+
+    // Número de posições livres aguardando reuso ou compactação.
+    size_t getPosicoesLivres() const;
+
+    // Compactação incremental: executa no máximo 'maxPassos' passos, cada um O(log L).
+    // Um passo move o último registro ativo para a menor posição livre (avisando 'aoMover')
+    // ou descarta um registro deletado do final da EDL.
+    // Retorna true se ainda houver buracos a fechar, para que o chamador continue depois.
+    // Registros deletados sem 'removerRegistro' (direto pelo Registro) só saem se ficarem no final.
+    bool compactar(size_t maxPassos, const AoMoverRegistro& aoMover);
+
     // Retorna o número atual de registros na EDL.
     size_t getTamanho() const;
 
+    // Memória ocupada pelo vetor de registros e pelos textos alocados no heap, em bytes.
+    size_t getMemoriaBytes() const;
+
     // Imprime todos os registros armazenados na EDL, incluindo os marcados como deletados.
     void imprimirTodosRegistros() const;
 
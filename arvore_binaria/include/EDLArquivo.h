@@ -0,0 +1,115 @@
+#ifndef EDL_ARQUIVO_H
+#define EDL_ARQUIVO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Registro.h"
+
+// Registro no formato do arquivo: campos de texto com tamanho fixo, completados com '\0'
+// (um campo que ocupa todo o espaço não tem terminador). Cada registro ocupa exatamente
+// TAM_REGISTRO_ARQUIVO bytes, então o registro i começa no byte i * TAM_REGISTRO_ARQUIVO
+// da área de registros e a busca por posição é só uma conta de endereço.
+struct RegistroArquivo {
+    static const size_t TAM_CPF = 14;  // "111.111.111-11"
+    static const size_t TAM_DATA = 10; // "01/01/1990"
+    static const size_t TAM_NOME = 70;
+
+    char cpf[TAM_CPF];
+    char dataNascimento[TAM_DATA];
+    char sexo;
+    char deletado; // 1 se o registro está logicamente deletado
+    char nome[TAM_NOME];
+
+    // Getters no mesmo formato do Registro (cópias, sem os '\0' de preenchimento).
+    std::string getCpf() const { return campo(cpf, TAM_CPF); }
+    std::string getNome() const { return campo(nome, TAM_NOME); }
+    std::string getDataNascimento() const { return campo(dataNascimento, TAM_DATA); }
+    char getSexo() const { return sexo; }
+    bool isDeletado() const { return deletado != 0; }
+
+    // Marca o registro como deletado e limpa os dados pessoais, como Registro::marcarComoDeletado.
+    void marcarComoDeletado();
+
+    // Converte para um Registro em memória.
+    Registro paraRegistro() const;
+
+    // Imprime no mesmo formato de Registro::imprimir.
+    void imprimir() const;
+
+private:
+    static std::string campo(const char* texto, size_t tamanho);
+};
+
+const size_t TAM_REGISTRO_ARQUIVO = 96;
+static_assert(sizeof(RegistroArquivo) == TAM_REGISTRO_ARQUIVO, "RegistroArquivo deve ter 96 bytes");
+
+// EDL persistente: o "arquivo de registros" passa a ser de fato um arquivo binário,
+// acessado por mmap. Formato:
+//   * cabeçalho de 64 bytes (assinatura "EDLARQ01", versão, tamanho do registro, quantidade);
+//   * registros de TAM_REGISTRO_ARQUIVO bytes, na ordem de inserção.
+// Abrir um arquivo existente só mapeia o arquivo (não lê nem converte os registros), então
+// a inicialização é quase instantânea, e o sistema operacional carrega e descarta páginas
+// sob demanda, permitindo bases maiores que a memória RAM.
+// O arquivo é reservado com folga e cresce geometricamente; ao fechar, é truncado para
+// o tamanho exato. Requer um sistema POSIX (mmap).
+class EDLArquivo {
+public:
+    // Abre o arquivo em 'caminho', criando-o vazio se não existir.
+    // Lança std::runtime_error se não for possível abrir/mapear o arquivo
+    // ou se ele não estiver no formato esperado.
+    explicit EDLArquivo(const std::string& caminho);
+
+    // Grava as alterações pendentes, desfaz o mapeamento e fecha o arquivo.
+    ~EDLArquivo();
+
+    EDLArquivo(const EDLArquivo&) = delete;
+    EDLArquivo& operator=(const EDLArquivo&) = delete;
+
+    // Busca um registro pela sua posição: devolve uma referência para dentro do mapeamento.
+    // Lança std::out_of_range se o índice for inválido. A referência é invalidada quando
+    // uma inserção faz o arquivo crescer (o mapeamento pode mudar de endereço).
+    const RegistroArquivo& buscarPorPosicao(int indice) const;
+
+    // Versão não-constante, para 'marcarComoDeletado'. As alterações vão direto para o arquivo.
+    RegistroArquivo& buscarPorPosicaoParaModificacao(int indice);
+
+    // Insere um novo registro no final do arquivo e retorna sua posição.
+    // Lança std::length_error se algum campo não couber no tamanho fixo.
+    int inserirRegistro(const Registro& novoRegistro);
+
+    // Número de registros no arquivo (incluindo os deletados).
+    size_t getTamanho() const;
+
+    // Imprime todos os registros, incluindo os marcados como deletados.
+    void imprimirTodosRegistros() const;
+
+    // Força a gravação das páginas alteradas no disco (msync).
+    void sincronizar();
+
+private:
+    // Cabeçalho do arquivo, no início do mapeamento.
+    struct Cabecalho {
+        char assinatura[8];
+        uint32_t versao;
+        uint32_t tamanhoRegistro;
+        uint64_t quantidade;
+        char reservado[40];
+    };
+
+    std::string caminho;
+    int descritor;       // Descritor do arquivo aberto
+    char* mapa;          // Início do mapeamento (cabeçalho seguido dos registros)
+    size_t bytesMapeados;
+
+    Cabecalho* cabecalho() const { return reinterpret_cast<Cabecalho*>(mapa); }
+    RegistroArquivo* registros() const { return reinterpret_cast<RegistroArquivo*>(mapa + sizeof(Cabecalho)); }
+
+    // Quantos registros cabem no espaço mapeado atual.
+    size_t capacidade() const;
+
+    // Ajusta o tamanho do arquivo e o mapeia (desfazendo o mapeamento anterior, se houver).
+    void remapear(size_t bytes);
+};
+
+#endif // EDL_ARQUIVO_H
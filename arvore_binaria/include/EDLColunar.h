@@ -0,0 +1,103 @@
+#ifndef EDL_COLUNAR_H
+#define EDL_COLUNAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Registro.h"
+#include "abb/ChaveCPF.h"
+
+class EDLColunar;
+
+// Visão leve de um registro da EDLColunar: guarda só a EDL e a posição, e lê cada campo
+// direto da coluna correspondente, sem copiar o registro.
+// Vale enquanto a EDL existir; uma inserção pode invalidar as string_view devolvidas.
+class RegistroColunar {
+private:
+    const EDLColunar* edl;
+    size_t posicao;
+
+public:
+    RegistroColunar(const EDLColunar& edl, size_t posicao) : edl(&edl), posicao(posicao) {}
+
+    // CPF no formato "111.111.111-11", como em Registro::getCpf.
+    std::string getCpf() const;
+    // O CPF como está na coluna, pronto para o índice (sem conversão de texto).
+    ChaveCPF getChaveCPF() const;
+    std::string_view getNome() const;
+    std::string_view getDataNascimento() const;
+    char getSexo() const;
+    bool isDeletado() const;
+
+    // Cópia completa em um Registro.
+    Registro paraRegistro() const;
+
+    // Imprime no mesmo formato de Registro::imprimir.
+    void imprimir() const;
+};
+
+// EDL com armazenamento por colunas ("structure of arrays"), alternativa à EDL de Registro.
+// Cada campo fica em um vetor próprio, com tamanho fixo por registro:
+//   * CPF: ChaveCPF (8 bytes, os 11 dígitos empacotados);
+//   * data de nascimento: 10 caracteres ("01/01/1990");
+//   * sexo e flag de deleção: 1 byte cada;
+//   * nome: identificador de 4 bytes de um nome em um repositório único e contíguo.
+// Os nomes são internados: nomes repetidos são guardados uma só vez no repositório.
+// Assim cada registro ocupa cerca de 24 bytes mais a parte dos nomes distintos, contra
+// sizeof(Registro) (três std::string) mais os blocos de heap dos textos longos.
+// O CPF precisa ser válido (11 dígitos), pois é guardado já convertido.
+class EDLColunar {
+public:
+    static const size_t TAM_DATA = 10; // "01/01/1990"
+
+    EDLColunar();
+
+    // Insere um novo registro no final e retorna sua posição.
+    // Lança std::invalid_argument se o CPF for inválido e std::length_error se a data
+    // tiver mais de TAM_DATA caracteres.
+    int inserirRegistro(const Registro& novoRegistro);
+
+    // Visão do registro na posição. Lança std::out_of_range se o índice for inválido.
+    RegistroColunar buscarPorPosicao(int indice) const;
+
+    // Marca o registro como deletado e limpa nome, data e sexo, como Registro::marcarComoDeletado.
+    // Lança std::out_of_range se o índice for inválido.
+    void marcarComoDeletado(int indice);
+
+    // Número de registros (incluindo os deletados).
+    size_t getTamanho() const;
+
+    // Imprime todos os registros, incluindo os marcados como deletados.
+    void imprimirTodosRegistros() const;
+
+    // Número de nomes distintos guardados no repositório.
+    size_t getNomesDistintos() const;
+
+    // Memória ocupada pelas colunas, pelo repositório de nomes e pela tabela de internação, em bytes.
+    size_t getMemoriaBytes() const;
+
+private:
+    friend class RegistroColunar;
+
+    std::vector<ChaveCPF> cpfs;
+    std::vector<char> datas;            // TAM_DATA caracteres por registro, completados com '\0'
+    std::vector<char> sexos;
+    std::vector<uint8_t> deletados;     // 1 se o registro está logicamente deletado
+    std::vector<uint32_t> nomes;        // Identificador do nome de cada registro
+
+    std::string repositorioNomes;       // Nomes distintos, um após o outro
+    std::vector<uint32_t> inicioNomes;  // O nome i ocupa [inicioNomes[i], inicioNomes[i + 1])
+    std::unordered_multimap<size_t, uint32_t> nomesPorHash; // Hash do nome -> identificadores
+
+    // Identificador do nome no repositório, acrescentando-o se ainda não existir.
+    uint32_t internarNome(std::string_view nome);
+
+    std::string_view nomeDoIdentificador(uint32_t id) const;
+
+    void validarIndice(int indice, const char* metodo) const;
+};
+
+#endif // EDL_COLUNAR_H
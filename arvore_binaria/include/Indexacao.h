@@ -0,0 +1,62 @@
+#ifndef INDEXACAO_H
+#define INDEXACAO_H
+
+#include "EDL.h"
+#include "EDLArquivo.h"
+#include "EDLColunar.h"
+#include "abb/ABB.h"
+#include "bmais/ArvoreBMais.h"
+#include <vector>
+
+// Operações que envolvem ao mesmo tempo o "arquivo de registros" (EDL)
+// e o "arquivo de índices" (ABB, ou a Árvore B+ como índice alternativo).
+
+// Reconstrói o índice de CPFs a partir da EDL: percorre todos os registros,
+// ignora os marcados como deletados e recarrega a ABB com uma carga em lote
+// (árvore perfeitamente balanceada). O conteúdo anterior do índice é descartado.
+// Se houver CPFs repetidos entre registros ativos, permanece o de menor posição.
+void reconstruirIndice(ABB& indice, const EDL& edl);
+
+// O mesmo, a partir de uma EDL em arquivo: ao reabrir a base, basta mapear o arquivo
+// e reconstruir o índice, sem reler e converter os registros para Registro.
+void reconstruirIndice(ABB& indice, const EDLArquivo& edl);
+
+// O mesmo, a partir de uma EDL colunar.
+void reconstruirIndice(ABB& indice, const EDLColunar& edl);
+
+// As mesmas reconstruções para um índice em Árvore B+ (carga em lote de baixo para cima).
+void reconstruirIndice(ArvoreBMais& indice, const EDL& edl);
+void reconstruirIndice(ArvoreBMais& indice, const EDLArquivo& edl);
+void reconstruirIndice(ArvoreBMais& indice, const EDLColunar& edl);
+
+// Remove o registro do CPF: retira a chave do índice e libera a posição na EDL para reuso
+// (EDL::removerRegistro). Retorna false se o CPF não estiver no índice.
+bool removerPorCPF(ABB& indice, EDL& edl, const ChaveCPF& cpf);
+bool removerPorCPF(ArvoreBMais& indice, EDL& edl, const ChaveCPF& cpf);
+
+// Executa até 'maxPassos' passos da compactação incremental da EDL, corrigindo no índice
+// a posição de cada registro movido. Retorna true se ainda houver buracos a fechar.
+// Ex.: 'while (compactarEDL(edl, indice, 1000)) { atender outras requisições }'.
+bool compactarEDL(EDL& edl, ABB& indice, size_t maxPassos);
+
+// Gera uma nova EDL com os registros ativos ordenados por CPF (Requisito 6), na ordem do
+// percurso em ordem do índice. O percurso é dividido em faixas de ordem (usando o tamanho
+// das subárvores da ABB), e cada thread copia a sua faixa direto para a posição final
+// do vetor de saída, reservado uma única vez. 'threads' = 0 usa uma thread por núcleo.
+// Entradas do índice que apontam para posições inválidas ou registros deletados são ignoradas.
+EDL gerarEDLOrdenada(const ABB& indice, const EDL& edl, size_t threads = 0);
+
+// Busca em lote de registros pelo CPF (ex.: conciliações com milhões de CPFs).
+// Para cada cpfs[i], posicoes[i] recebe a posição na EDL (ou -1) e registros[i]
+// aponta para o Registro encontrado (ou nullptr, se o CPF não estiver no índice ou
+// o registro estiver deletado). As chaves são processadas em blocos: a busca em lote
+// da ABB resolve as posições do bloco e, no mesmo passo, os registros são trazidos
+// para o cache antes de serem lidos. Os ponteiros valem enquanto a EDL não for alterada.
+void buscarRegistrosEmLote(const ABB& indice, const EDL& edl, const std::vector<ChaveCPF>& cpfs,
+                           std::vector<int>& posicoes, std::vector<const Registro*>& registros);
+
+// O mesmo com o índice em Árvore B+: as posições do bloco são buscadas uma a uma.
+void buscarRegistrosEmLote(const ArvoreBMais& indice, const EDL& edl, const std::vector<ChaveCPF>& cpfs,
+                           std::vector<int>& posicoes, std::vector<const Registro*>& registros);
+
+#endif // INDEXACAO_H
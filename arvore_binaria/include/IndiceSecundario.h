@@ -0,0 +1,139 @@
+#ifndef INDICE_SECUNDARIO_H
+#define INDICE_SECUNDARIO_H
+
+#include <cstddef>
+#include <limits>  // Para std::numeric_limits (limites das faixas de posições)
+#include <string>
+#include <utility> // Para std::move
+#include <vector>
+#include "EDL.h"
+#include "abb/ABB.h"
+
+// Índice secundário (não único) sobre um campo dos registros da EDL, ex.: nome -> posições.
+// O campo é escolhido pelo parâmetro 'Extrator', que deve fornecer:
+//   * static std::string chave(const Registro& registro): o valor indexado do registro;
+//   * static std::string normalizar(const std::string& valor): converte um valor de consulta
+//     para a mesma forma devolvida por 'chave' (ex.: datas "dd/mm/aaaa" -> "aaaa/mm/dd").
+// A árvore guarda uma ChaveSecundaria (valor, posição) por registro ativo, então valores
+// repetidos são permitidos e as posições de um mesmo valor saem em ordem crescente.
+// Quem altera a EDL é responsável por manter o índice em dia (inserir, remover, mover),
+// como faz o BancoDados com os índices de nome e de data de nascimento.
+template <typename Extrator>
+class IndiceSecundario {
+public:
+    IndiceSecundario() : arvore(TipoBalanceamento::AVL) {}
+
+    // Indexa o registro que está em 'posicao'. Registros deletados são ignorados.
+    void inserir(const Registro& registro, int posicao) {
+        if (!registro.isDeletado()) {
+            arvore.inserir(EntradaIndiceGenerica<ChaveSecundaria>(chaveDe(registro, posicao), posicao));
+        }
+    }
+
+    // Retira o registro de 'posicao'; deve ser chamado antes de o registro ser apagado
+    // da EDL, enquanto o campo ainda pode ser lido. Retorna false se ele não estava indexado.
+    bool remover(const Registro& registro, int posicao) {
+        ChaveSecundaria chave = chaveDe(registro, posicao);
+        if (registro.isDeletado() || arvore.buscarPosicao(chave) == -1) {
+            return false;
+        }
+        arvore.remover(chave);
+        return true;
+    }
+
+    // O registro passou de 'posicaoAntiga' para 'posicaoNova' (compactação da EDL).
+    // Como a posição faz parte da chave, a entrada é removida e inserida de novo: O(log n).
+    void mover(const Registro& registro, int posicaoAntiga, int posicaoNova) {
+        if (remover(registro, posicaoAntiga)) {
+            inserir(registro, posicaoNova);
+        }
+    }
+
+    // Descarta o conteúdo atual e indexa todos os registros ativos da EDL,
+    // com uma carga em lote (ordenação paralela e árvore perfeitamente balanceada).
+    void reconstruir(const EDL& edl) {
+        std::vector<EntradaIndiceGenerica<ChaveSecundaria> > entradas;
+        entradas.reserve(edl.getTamanho());
+        for (size_t i = 0; i < edl.getTamanho(); ++i) {
+            const Registro& registro = edl.buscarPorPosicao(static_cast<int>(i));
+            if (!registro.isDeletado()) {
+                int posicao = static_cast<int>(i);
+                entradas.push_back(EntradaIndiceGenerica<ChaveSecundaria>(chaveDe(registro, posicao), posicao));
+            }
+        }
+        arvore.carregarEmLote(std::move(entradas), false);
+    }
+
+    // Consultas. Todas descem a árvore uma única vez: O(log n + k) para k posições,
+    // em vez de percorrer a EDL inteira.
+
+    // Posições dos registros com o campo igual a 'valor', em ordem crescente de posição.
+    std::vector<int> buscar(const std::string& valor) const {
+        std::string normalizado = Extrator::normalizar(valor);
+        return arvore.buscarIntervalo(limiteInferior(normalizado), limiteSuperior(normalizado));
+    }
+
+    // Quantos registros têm o campo igual a 'valor', sem percorrê-los: O(log n).
+    size_t contar(const std::string& valor) const {
+        std::string normalizado = Extrator::normalizar(valor);
+        return arvore.contarIntervalo(limiteInferior(normalizado), limiteSuperior(normalizado));
+    }
+
+    // Posições dos registros com o campo em [inicio, fim], em ordem de campo (e de posição,
+    // entre valores iguais).
+    std::vector<int> buscarIntervalo(const std::string& inicio, const std::string& fim) const {
+        return arvore.buscarIntervalo(limiteInferior(Extrator::normalizar(inicio)),
+                                      limiteSuperior(Extrator::normalizar(fim)));
+    }
+
+    // Posições dos registros cujo campo, na forma normalizada, começa com 'prefixo'
+    // (ex.: "Ana" no índice de nomes; "1990/" no de datas, que guarda "aaaa/mm/dd").
+    std::vector<int> buscarPrefixo(const std::string& prefixo) const {
+        return arvore.buscarPrefixo(prefixo);
+    }
+
+    // Número de registros indexados.
+    size_t getTamanho() const { return arvore.getTamanho(); }
+
+    const ABBSecundaria& getArvore() const { return arvore; }
+
+private:
+    ABBSecundaria arvore;
+
+    static ChaveSecundaria chaveDe(const Registro& registro, int posicao) {
+        return ChaveSecundaria(Extrator::chave(registro), posicao);
+    }
+
+    // Limites que cercam todas as posições de um mesmo valor.
+    static ChaveSecundaria limiteInferior(const std::string& valor) {
+        return ChaveSecundaria(valor, std::numeric_limits<int>::min());
+    }
+    static ChaveSecundaria limiteSuperior(const std::string& valor) {
+        return ChaveSecundaria(valor, std::numeric_limits<int>::max());
+    }
+};
+
+// Extrator do nome, comparado exatamente como foi cadastrado.
+struct ExtratorNome {
+    static std::string chave(const Registro& registro) { return registro.getNome(); }
+    static std::string normalizar(const std::string& nome) { return nome; }
+};
+
+// Extrator da data de nascimento. As datas "dd/mm/aaaa" são guardadas como "aaaa/mm/dd",
+// para que a ordem do texto seja a ordem cronológica e as consultas por intervalo de datas
+// funcionem. Textos em outro formato são indexados como estão.
+struct ExtratorDataNascimento {
+    static std::string chave(const Registro& registro) { return normalizar(registro.getDataNascimento()); }
+
+    static std::string normalizar(const std::string& data) {
+        if (data.size() != 10 || data[2] != '/' || data[5] != '/') {
+            return data;
+        }
+        return data.substr(6, 4) + '/' + data.substr(3, 2) + '/' + data.substr(0, 2);
+    }
+};
+
+typedef IndiceSecundario<ExtratorNome> IndiceNome;
+typedef IndiceSecundario<ExtratorDataNascimento> IndiceDataNascimento;
+
+#endif // INDICE_SECUNDARIO_H
@@ -50,6 +50,12 @@ public:
         flagDeletado = false;
     }
 
+    // Bytes alocados no heap pelos textos do registro (textos curtos ficam dentro do
+    // próprio std::string, pela otimização de strings pequenas, e não contam).
+    size_t getBytesHeap() const {
+        return bytesHeap(cpf) + bytesHeap(nome) + bytesHeap(dataNascimento);
+    }
+
     // Imprime os detalhes do registro no console.
     void imprimir() const {
         if (flagDeletado) {
@@ -61,6 +67,13 @@ public:
                       << "Sexo: " << sexo << std::endl;
         }
     }
+
+private:
+    static size_t bytesHeap(const std::string& texto) {
+        const char* inicioObjeto = reinterpret_cast<const char*>(&texto);
+        bool interno = texto.data() >= inicioObjeto && texto.data() < inicioObjeto + sizeof(texto);
+        return interno ? 0 : texto.capacity() + 1;
+    }
 };
 
 #endif // REGISTRO_H
\ No newline at end of file
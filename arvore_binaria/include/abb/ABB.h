@@ -2,82 +2,248 @@
 #define ABB_H
 
 #include "abb/NoABB.h"
+#include "abb/ArenaNos.h"
+#include "abb/ChaveSecundaria.h"
+#include <cstddef>          // Para std::ptrdiff_t
+#include <functional>       // Para std::function (visitantes dos percursos)
 #include <initializer_list> // Para construtores com lista de inicialização
-#include <vector>           // Potencialmente usado em percursos ou métodos auxiliares
+#include <iterator>         // Para std::forward_iterator_tag
+#include <vector>           // Para a carga em lote, pilhas dos percursos e métodos auxiliares
 #include <queue>            // Para percurso em largura
 #include <string>           // Para chaves de busca e remoção
 
-// Forward declaration para a classe EDL, necessária para a função friend.
-// Permite que o compilador saiba que EDL é uma classe sem a necessidade de incluir "EDL.h" aqui,
-// evitando inclusão circular em cenários mais complexos.
-class EDL;
+// Estratégia de balanceamento usada pela ABB.
+// NENHUM mantém o comportamento clássico (a altura depende da ordem de inserção);
+// AVL aplica rotações após inserções e remoções, garantindo altura O(log n)
+// mesmo quando as chaves chegam ordenadas.
+enum class TipoBalanceamento {
+    NENHUM,
+    AVL
+};
 
 // Classe que implementa a estrutura de dados Árvore Binária de Busca (ABB).
 // Gerencia a hierarquia de nós (NoABB) e fornece operações de manipulação e percurso.
-class ABB {
+// O tipo da chave é um parâmetro do template; as instâncias usadas pelo sistema
+// (ChaveCPF, std::string e ChaveSecundaria) são instanciadas explicitamente em ABB.cpp.
+template <typename Chave>
+class ABBGenerica {
+public:
+    typedef EntradaIndiceGenerica<Chave> Entrada;
+    typedef NoABBGenerico<Chave> No;
+    typedef typename ArenaNos<No>::Indice Indice; // Referência a um nó dentro da arena
+
+    // Função chamada para cada entrada visitada pelos percursos.
+    typedef std::function<void(const Entrada&)> Visitante;
+
+    // Iterador de percurso em ordem (crescente) ou em ordem reversa (decrescente).
+    // Guarda em uma pilha explícita o caminho de nós ainda não visitados, então
+    // não há recursão: a memória extra é O(altura) e cada avanço custa O(1) amortizado.
+    // Como qualquer iterador de contêiner, é invalidado por inserções e remoções na árvore.
+    class IteradorEmOrdem {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Entrada value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Entrada* pointer;
+        typedef const Entrada& reference;
+
+        // Iterador de fim (pilha vazia).
+        IteradorEmOrdem() : arena(nullptr), reverso(false) {}
+
+        IteradorEmOrdem(const ArenaNos<No>& arena, Indice raiz, bool reverso)
+            : arena(&arena), reverso(reverso) {
+            descer(raiz);
+        }
+
+        reference operator*() const { return (*arena)[pilha.back()].dado; }
+        pointer operator->() const { return &(*arena)[pilha.back()].dado; }
+
+        // Avança para o sucessor (ou predecessor, no modo reverso): o próximo nó
+        // é o mais à esquerda da subárvore direita, ou o ancestral no topo da pilha.
+        IteradorEmOrdem& operator++() {
+            Indice no = pilha.back();
+            pilha.pop_back();
+            descer(reverso ? (*arena)[no].esq : (*arena)[no].dir);
+            return *this;
+        }
+
+        IteradorEmOrdem operator++(int) {
+            IteradorEmOrdem anterior(*this);
+            ++(*this);
+            return anterior;
+        }
+
+        bool operator==(const IteradorEmOrdem& outro) const {
+            if (pilha.empty() || outro.pilha.empty()) {
+                return pilha.empty() && outro.pilha.empty();
+            }
+            return pilha.back() == outro.pilha.back();
+        }
+
+        bool operator!=(const IteradorEmOrdem& outro) const { return !(*this == outro); }
+
+    private:
+        friend class ABBGenerica; // lowerBound/upperBound montam a pilha diretamente
+
+        const ArenaNos<No>* arena;
+        std::vector<Indice> pilha; // Nós cujo dado ainda não foi visitado (o topo é o atual)
+        bool reverso;
+
+        // Empilha o caminho mais à esquerda (ou mais à direita, no modo reverso) a partir de 'no'.
+        void descer(Indice no) {
+            while (no != INDICE_NULO) {
+                pilha.push_back(no);
+                no = reverso ? (*arena)[no].dir : (*arena)[no].esq;
+            }
+        }
+    };
+
 private:
-    NoABB* raiz; // Ponteiro para a raiz da árvore
+    ArenaNos<No> arena;                // Blocos onde os nós são alocados
+    Indice raiz;                       // Índice da raiz na arena (INDICE_NULO se vazia)
+    TipoBalanceamento balanceamento;   // Estratégia escolhida na construção
+    size_t quantidade;                 // Número de entradas armazenadas
 
-    // Métodos auxiliares recursivos e privados para gerenciamento interno da ABB.
+    // Um passo do caminho da raiz até o ponto de inserção ou remoção:
+    // o nó visitado e o lado pelo qual a descida continuou.
+    struct Passo {
+        Indice no;
+        bool esquerda;
+    };
 
-    // Desaloca recursivamente todos os nós de uma subárvore.
-    void destruirRecursivo(NoABB* no);
+    // Métodos auxiliares privados para gerenciamento interno da ABB.
 
-    // Cria uma cópia profunda (recursiva) de uma subárvore.
-    NoABB* copiarRecursivo(const NoABB* noOriginal);
+    // Pendura 'subarvore' no último nó do caminho (do lado registrado) e sobe até a raiz,
+    // atualizando alturas e tamanhos e rebalanceando. Quando uma subárvore não muda de raiz
+    // nem de altura, os ancestrais não precisam mais de rotações: só o tamanho é corrigido.
+    void religarCaminho(const std::vector<Passo>& caminho, Indice subarvore);
 
-    // Lógica recursiva para inserir uma nova EntradaIndice na subárvore.
-    NoABB* inserirRecursivo(NoABB* noAtual, const EntradaIndice& novaEntrada);
+    // Auxiliares do balanceamento AVL.
+    int alturaDe(Indice no) const;            // Altura de uma subárvore (0 para INDICE_NULO)
+    uint32_t tamanhoDe(Indice no) const;      // Número de nós de uma subárvore (0 para INDICE_NULO)
+    void atualizarAltura(Indice no);          // Recalcula a altura e o tamanho a partir dos filhos
+    int fatorBalanceamento(Indice no) const;  // altura(esq) - altura(dir)
+    Indice rotacionarDireita(Indice no);
+    Indice rotacionarEsquerda(Indice no);
 
-    // Lógica recursiva para remover um nó com uma dada chave de uma subárvore.
-    NoABB* removerRecursivo(NoABB* noAtual, const std::string& chaveRemover);
-    
-    // Encontra o nó com a menor chave em uma subárvore (utilizado na remoção).
-    NoABB* encontrarMin(NoABB* no);
+    // Atualiza a altura do nó e, no modo AVL, aplica as rotações necessárias.
+    // Retorna a nova raiz da subárvore.
+    Indice rebalancear(Indice no);
 
-    // Métodos recursivos para os percursos da árvore.
-    void preOrdemRecursivo(NoABB* no) const;
-    void emOrdemRecursivo(NoABB* no) const;
-    void posOrdemRecursivo(NoABB* no) const;
+    // Monta uma subárvore perfeitamente balanceada com as entradas [inicio, fim)
+    // de um vetor ordenado, usando o elemento do meio como raiz. Retorna a raiz.
+    Indice construirBalanceadaRecursivo(const std::vector<Entrada>& entradas, size_t inicio, size_t fim);
 
-    // Declara a função global 'gerarEDLOrdenada' como friend para permitir
-    // acesso direto à 'raiz' da ABB para fins de percurso.
-    // Em um design de produção mais robusto, um iterador ou um método público
-    // na ABB para coletar os dados seria preferível.
-    friend void gerarEDLOrdenada(const ABB& abbIndices, const EDL& edlOriginal);
 
 public:
     // Construtores da ABB:
 
-    // Construtor padrão: cria uma ABB vazia (raiz nula).
-    ABB();
+    // Construtor padrão: cria uma ABB vazia (raiz nula) com a estratégia de balanceamento indicada.
+    explicit ABBGenerica(TipoBalanceamento tipo = TipoBalanceamento::NENHUM);
 
     // Construtor a partir de uma lista de inicialização de EntradaIndice.
     // Insere cada elemento da lista na ABB.
-    ABB(std::initializer_list<EntradaIndice> lista);
+    ABBGenerica(std::initializer_list<Entrada> lista,
+        TipoBalanceamento tipo = TipoBalanceamento::NENHUM);
+
+    // Construtor de carga em lote: equivalente a criar uma ABB vazia e chamar carregarEmLote.
+    ABBGenerica(std::vector<Entrada> entradas, bool jaOrdenadas,
+                TipoBalanceamento tipo = TipoBalanceamento::NENHUM);
 
     // Construtor de cópia: realiza uma cópia profunda de outra ABB.
-    ABB(const ABB& outraABB);
+    ABBGenerica(const ABBGenerica& outraABB);
 
     // Operador de atribuição de cópia: permite atribuir uma ABB a outra,
     // garantindo cópia profunda e segurança.
-    ABB& operator=(const ABB& outraABB);
+    ABBGenerica& operator=(const ABBGenerica& outraABB);
 
-    // Destrutor: garante a liberação correta de toda a memória alocada pelos nós.
-    ~ABB();
+    // Destrutor: garante a liberação correta de toda a memória alocada pelos nós
+    // (a arena libera um bloco por vez, sem percorrer a árvore).
+    ~ABBGenerica();
 
     // Métodos de manipulação da ABB (API pública):
 
     // Insere uma nova EntradaIndice na ABB.
-    void inserir(const EntradaIndice& novaEntrada);
+    // Inserção e remoção são iterativas (caminho em um vetor, e não na pilha de chamadas),
+    // então nem uma ABB simples degenerada pelas chaves ordenadas estoura a pilha.
+    void inserir(const Entrada& novaEntrada);
 
     // Remove um nó da ABB identificado por sua chave (CPF).
-    void remover(const std::string& chaveRemover);
+    void remover(const Chave& chaveRemover);
+
+    // Troca a posição na EDL associada à chave de 'posicaoAntiga' para 'posicaoNova'
+    // (usado quando a EDL move registros ao compactar). Só altera se a chave existir e
+    // apontar para 'posicaoAntiga'; retorna true se alterou. O(altura), sem mudar a forma da árvore.
+    bool atualizarPosicao(const Chave& chave, int posicaoAntiga, int posicaoNova);
 
     // Deleta todos os nós da ABB, liberando a memória e tornando-a vazia.
     void deletarABB();
 
-    // Métodos para realizar os diferentes tipos de percursos na ABB.
+    // Carga em lote: descarta o conteúdo atual e monta uma árvore perfeitamente
+    // balanceada (altura mínima, válida também como AVL) com as entradas fornecidas.
+    // Se 'jaOrdenadas' for true, as entradas devem estar em ordem crescente de chave
+    // e a construção é O(n); caso contrário, são ordenadas antes em paralelo (O(n log n)).
+    // Chaves repetidas são recusadas como em 'inserir', mantendo a de menor posição na EDL.
+    void carregarEmLote(std::vector<Entrada> entradas, bool jaOrdenadas);
+
+    // Percursos com visitante: chamam 'visitar' para cada entrada, na ordem do percurso.
+    // São iterativos (pilha ou fila explícita), então funcionam em árvores de qualquer altura.
+    void visitarPreOrdem(const Visitante& visitar) const;
+    void visitarEmOrdem(const Visitante& visitar) const;
+    void visitarPosOrdem(const Visitante& visitar) const;
+    void visitarEmLargura(const Visitante& visitar) const;
+
+    // Iteradores do percurso em ordem, permitindo 'for (const EntradaIndice& e : abb)'.
+    // begin/end percorrem as chaves em ordem crescente; rbegin/rend, em ordem decrescente.
+    IteradorEmOrdem begin() const { return IteradorEmOrdem(arena, raiz, false); }
+    IteradorEmOrdem end() const { return IteradorEmOrdem(); }
+    IteradorEmOrdem rbegin() const { return IteradorEmOrdem(arena, raiz, true); }
+    IteradorEmOrdem rend() const { return IteradorEmOrdem(); }
+
+    // Consultas por faixa de chaves. Descem uma única vez da raiz e depois avançam
+    // pelo iterador, então custam O(log n + k) para k chaves encontradas (na AVL).
+
+    // Iterador para a entrada de ordem 'ordem' na sequência crescente de chaves
+    // (0 = menor chave), ou end() se ordem >= getTamanho(). Desce uma vez usando
+    // o tamanho das subárvores: O(altura). Permite dividir o percurso em faixas.
+    IteradorEmOrdem iteradorNaOrdem(size_t ordem) const;
+
+    // Iterador para a primeira chave >= 'chave' (ou end(), se não houver).
+    IteradorEmOrdem lowerBound(const Chave& chave) const;
+
+    // Iterador para a primeira chave > 'chave' (ou end(), se não houver).
+    IteradorEmOrdem upperBound(const Chave& chave) const;
+
+    // Chama 'visitar' para cada entrada com inicio <= chave <= fim, em ordem crescente.
+    void visitarIntervalo(const Chave& inicio, const Chave& fim, const Visitante& visitar) const;
+
+    // Posições na EDL das chaves em [inicio, fim], em ordem crescente de chave.
+    std::vector<int> buscarIntervalo(const Chave& inicio, const Chave& fim) const;
+
+    // Posições na EDL das chaves que começam com 'prefixo', em ordem crescente de chave.
+    // Para CPFs, o prefixo é comparado por dígitos ("123.456" equivale a "123456"),
+    // e caracteres inválidos lançam std::invalid_argument.
+    std::vector<int> buscarPrefixo(const std::string& prefixo) const;
+
+    // Estatísticas de ordem, com o tamanho das subárvores guardado em cada nó.
+    // Cada consulta desce uma única vez da raiz: O(altura), O(log n) na AVL.
+
+    // "Rank": quantas chaves são menores que 'chave' (a chave não precisa existir).
+    // Se existir, é a sua ordem na sequência crescente (0 = menor chave).
+    size_t contarMenores(const Chave& chave) const;
+
+    // "Select": a entrada de ordem 'ordem' (0 = menor chave).
+    // Lança std::out_of_range se ordem >= getTamanho().
+    Entrada selecionar(size_t ordem) const;
+
+    // Quantas chaves estão em [inicio, fim], sem percorrê-las (0 se fim < inicio).
+    size_t contarIntervalo(const Chave& inicio, const Chave& fim) const;
+
+    // Paginação da listagem em ordem: as entradas da página 'numeroPagina' (a partir de 0),
+    // com até 'tamanhoPagina' entradas cada. O(log n + tamanhoPagina), qualquer que seja a página.
+    std::vector<Entrada> pagina(size_t numeroPagina, size_t tamanhoPagina) const;
+
+    // Métodos que imprimem os diferentes tipos de percursos na ABB.
     void preOrdem() const;
     void emOrdem() const; // Percurso em ordem simétrica (elementos em ordem crescente)
     void posOrdem() const;
@@ -85,7 +251,41 @@ public:
 
     // Busca a posição na EDL de um Registro dado sua chave (CPF).
     // Retorna a posição (índice) se encontrada, ou -1 caso contrário.
-    int buscarPosicao(const std::string& chaveBusca) const;
+    int buscarPosicao(const Chave& chaveBusca) const;
+
+    // Busca em lote: posicoes[i] recebe buscarPosicao(chaves[i]) para i em [0, numeroChaves).
+    // As buscas são feitas em grupos que descem a árvore juntos, um nível por rodada:
+    // enquanto um nó é comparado, os filhos das outras buscas do grupo já estão sendo
+    // trazidos da memória (prefetch), em vez de cada busca esperar um nó por vez.
+    void buscarPosicoes(const Chave* chaves, size_t numeroChaves, int* posicoes) const;
+    std::vector<int> buscarPosicoes(const std::vector<Chave>& chaves) const;
+
+    // Estatísticas da árvore, úteis para verificar o balanceamento.
+
+    // Altura da árvore (0 para árvore vazia, 1 para apenas a raiz). Custo O(1).
+    // No modo AVL, é garantido que altura <= 1,44 * log2(n + 2).
+    int getAltura() const;
+
+    // Profundidade média dos nós (raiz = 0). Percorre a árvore inteira: O(n).
+    double getProfundidadeMedia() const;
+
+    // Número de entradas armazenadas na ABB.
+    size_t getTamanho() const;
+
+    // Estratégia de balanceamento em uso.
+    TipoBalanceamento getBalanceamento() const;
+
+    // Memória reservada pela arena de nós, em bytes (inclui posições livres dos blocos).
+    size_t getMemoriaNos() const;
 };
 
+// Índice principal do sistema: CPF empacotado em 64 bits.
+typedef ABBGenerica<ChaveCPF> ABB;
+
+// Índice com chaves textuais, para campos que não são CPF.
+typedef ABBGenerica<std::string> ABBTexto;
+
+// Índices secundários (não únicos): chave (valor do campo, posição na EDL).
+typedef ABBGenerica<ChaveSecundaria> ABBSecundaria;
+
 #endif // ABB_H
\ No newline at end of file
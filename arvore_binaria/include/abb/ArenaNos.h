@@ -0,0 +1,120 @@
+#ifndef ARENA_NOS_H
+#define ARENA_NOS_H
+
+#include <algorithm> // Para std::copy
+#include <cstdint>
+#include <memory>    // Para std::unique_ptr
+#include <vector>
+
+// Índice que representa "nenhum nó" (equivalente a nullptr) em estruturas baseadas em arena.
+const uint32_t INDICE_NULO = 0xFFFFFFFFu;
+
+// Alocador de nós em blocos ("slabs") para a ABB.
+// Em vez de um 'new' por nó, os nós são criados em blocos de TAM_BLOCO posições,
+// e os filhos passam a ser referenciados por índices de 32 bits dentro da arena.
+// Consequências:
+//   * alocar um nó é O(1) e, na maior parte das vezes, só incrementa um contador;
+//   * nós removidos entram em uma lista livre e são reaproveitados;
+//   * limpar a arena libera um bloco por vez: O(número de blocos)
+//     (para nós trivialmente destrutíveis, como os de ChaveCPF);
+//   * copiar a arena é uma cópia bloco a bloco, sem realocar ponteiros,
+//     já que os índices continuam válidos na cópia.
+// O tipo No deve ter construtor padrão e um campo 'esq' do tipo Indice,
+// reutilizado como "próximo" da lista livre enquanto o nó está liberado.
+template <typename No>
+class ArenaNos {
+public:
+    typedef uint32_t Indice;
+
+    static const Indice NULO = INDICE_NULO;
+
+    // Cada bloco guarda 2^BITS_BLOCO nós.
+    static const unsigned BITS_BLOCO = 12;
+    static const Indice TAM_BLOCO = Indice(1) << BITS_BLOCO;
+    static const Indice MASCARA_BLOCO = TAM_BLOCO - 1;
+
+private:
+    std::vector<std::unique_ptr<No[]> > blocos; // Blocos alocados (endereços estáveis)
+    Indice proximoNovo;  // Próximo índice nunca usado
+    Indice listaLivre;   // Cabeça da lista de nós liberados (NULO se vazia)
+    size_t emUso;        // Nós atualmente alocados
+
+public:
+    ArenaNos() : proximoNovo(0), listaLivre(NULO), emUso(0) {}
+
+    // Cópia bloco a bloco: como os nós se referenciam por índices, nada precisa ser ajustado.
+    ArenaNos(const ArenaNos& outra) : proximoNovo(0), listaLivre(NULO), emUso(0) {
+        copiarDe(outra);
+    }
+
+    ArenaNos& operator=(const ArenaNos& outra) {
+        if (this != &outra) {
+            limpar();
+            copiarDe(outra);
+        }
+        return *this;
+    }
+
+    // Acesso a um nó pelo índice. O endereço permanece válido mesmo quando novos blocos são criados.
+    No& operator[](Indice indice) {
+        return blocos[indice >> BITS_BLOCO][indice & MASCARA_BLOCO];
+    }
+
+    const No& operator[](Indice indice) const {
+        return blocos[indice >> BITS_BLOCO][indice & MASCARA_BLOCO];
+    }
+
+    // Reserva um nó (reaproveitando a lista livre quando possível), inicializa-o
+    // com uma cópia de 'modelo' e devolve seu índice.
+    Indice alocar(const No& modelo) {
+        Indice indice;
+        if (listaLivre != NULO) {
+            indice = listaLivre;
+            listaLivre = (*this)[indice].esq;
+        } else {
+            if ((proximoNovo >> BITS_BLOCO) == blocos.size()) {
+                blocos.push_back(std::unique_ptr<No[]>(new No[TAM_BLOCO]));
+            }
+            indice = proximoNovo++;
+        }
+        (*this)[indice] = modelo;
+        ++emUso;
+        return indice;
+    }
+
+    // Devolve o nó à lista livre, para ser reaproveitado pela próxima alocação.
+    void liberar(Indice indice) {
+        (*this)[indice].esq = listaLivre;
+        listaLivre = indice;
+        --emUso;
+    }
+
+    // Libera todos os blocos de uma vez.
+    void limpar() {
+        blocos.clear();
+        proximoNovo = 0;
+        listaLivre = NULO;
+        emUso = 0;
+    }
+
+    // Número de nós alocados.
+    size_t getEmUso() const { return emUso; }
+
+    // Memória reservada pelos blocos, em bytes.
+    size_t getBytesReservados() const { return blocos.size() * TAM_BLOCO * sizeof(No); }
+
+private:
+    void copiarDe(const ArenaNos& outra) {
+        blocos.reserve(outra.blocos.size());
+        for (size_t b = 0; b < outra.blocos.size(); ++b) {
+            blocos.push_back(std::unique_ptr<No[]>(new No[TAM_BLOCO]));
+            // Para nós trivialmente copiáveis, std::copy se reduz a um memmove do bloco.
+            std::copy(outra.blocos[b].get(), outra.blocos[b].get() + TAM_BLOCO, blocos[b].get());
+        }
+        proximoNovo = outra.proximoNovo;
+        listaLivre = outra.listaLivre;
+        emUso = outra.emUso;
+    }
+};
+
+#endif // ARENA_NOS_H
@@ -0,0 +1,115 @@
+#ifndef CHAVE_CPF_H
+#define CHAVE_CPF_H
+
+#include <cstdint>
+#include <cstdio>    // Para std::snprintf
+#include <iostream>
+#include <stdexcept> // Para std::invalid_argument
+#include <string>
+
+// Chave compacta para CPFs: os 11 dígitos são empacotados em um inteiro de 64 bits.
+// A conversão de/para texto acontece apenas nas bordas (construção e impressão);
+// dentro do índice, cada comparação é uma única comparação de inteiros e a chave
+// ocupa 8 bytes, sem alocação no heap.
+// Como todos os CPFs têm 11 dígitos, a ordem numérica coincide com a ordem do texto formatado.
+class ChaveCPF {
+private:
+    uint64_t valor; // CPF como número (ex.: "111.111.111-11" -> 11111111111)
+
+public:
+    // Maior valor representável por 11 dígitos.
+    static const uint64_t VALOR_MAXIMO = 99999999999ULL;
+
+    // Construtor padrão: CPF "000.000.000-00".
+    ChaveCPF() : valor(0) {}
+
+    // Construtores a partir de texto, formatado ("111.111.111-11") ou só com dígitos ("11111111111").
+    // Não são explicit de propósito: permitem passar um std::string onde o índice espera uma ChaveCPF.
+    // Lançam std::invalid_argument se o texto não tiver exatamente 11 dígitos.
+    ChaveCPF(const std::string& cpf) : valor(converter(cpf.data(), cpf.size())) {}
+    ChaveCPF(const char* cpf) : valor(converter(cpf, std::char_traits<char>::length(cpf))) {}
+
+    // Cria a chave diretamente a partir do valor numérico.
+    static ChaveCPF deValor(uint64_t valor) {
+        if (valor > VALOR_MAXIMO) {
+            throw std::invalid_argument("ChaveCPF: valor com mais de 11 digitos.");
+        }
+        ChaveCPF chave;
+        chave.valor = valor;
+        return chave;
+    }
+
+    // Faixa [menor, maior] de todos os CPFs que começam com 'prefixo' (ex.: "123.456"
+    // -> 123.456.000-00 a 123.456.999-99). O prefixo pode ter de 0 a 11 dígitos, com ou
+    // sem separadores. Lança std::invalid_argument para caracteres inválidos ou mais de 11 dígitos.
+    static void faixaDoPrefixo(const std::string& prefixo, ChaveCPF& menor, ChaveCPF& maior) {
+        int digitos = 0;
+        uint64_t valorPrefixo = extrairDigitos(prefixo.data(), prefixo.size(), digitos);
+        if (digitos > 11) {
+            throw std::invalid_argument("ChaveCPF: prefixo com mais de 11 digitos: '" + prefixo + "'.");
+        }
+        uint64_t escala = 1;
+        for (int i = digitos; i < 11; ++i) {
+            escala *= 10;
+        }
+        menor.valor = valorPrefixo * escala;
+        maior.valor = menor.valor + escala - 1;
+    }
+
+    uint64_t getValor() const { return valor; }
+
+    // Formata como "111.111.111-11".
+    std::string formatar() const {
+        char texto[16];
+        std::snprintf(texto, sizeof(texto), "%03llu.%03llu.%03llu-%02llu",
+                      static_cast<unsigned long long>((valor / 100000000ULL) % 1000),
+                      static_cast<unsigned long long>((valor / 100000ULL) % 1000),
+                      static_cast<unsigned long long>((valor / 100ULL) % 1000),
+                      static_cast<unsigned long long>(valor % 100));
+        return texto;
+    }
+
+    bool operator<(const ChaveCPF& outra) const { return valor < outra.valor; }
+    bool operator==(const ChaveCPF& outra) const { return valor == outra.valor; }
+    bool operator!=(const ChaveCPF& outra) const { return valor != outra.valor; }
+    bool operator>(const ChaveCPF& outra) const { return valor > outra.valor; }
+    bool operator<=(const ChaveCPF& outra) const { return valor <= outra.valor; }
+    bool operator>=(const ChaveCPF& outra) const { return valor >= outra.valor; }
+
+private:
+    // Extrai os dígitos do texto, ignorando os separadores '.' e '-', e conta quantos são.
+    // Só os 11 primeiros dígitos entram no valor (o chamador rejeita textos com mais).
+    static uint64_t extrairDigitos(const char* texto, size_t tamanho, int& digitos) {
+        uint64_t resultado = 0;
+        digitos = 0;
+        for (size_t i = 0; i < tamanho; ++i) {
+            char c = texto[i];
+            if (c >= '0' && c <= '9') {
+                if (digitos < 11) {
+                    resultado = resultado * 10 + static_cast<uint64_t>(c - '0');
+                }
+                ++digitos;
+            } else if (c != '.' && c != '-') {
+                throw std::invalid_argument("ChaveCPF: caractere invalido em '" + std::string(texto, tamanho) + "'.");
+            }
+        }
+        return resultado;
+    }
+
+    // Converte um CPF completo (exatamente 11 dígitos).
+    static uint64_t converter(const char* texto, size_t tamanho) {
+        int digitos = 0;
+        uint64_t resultado = extrairDigitos(texto, tamanho, digitos);
+        if (digitos != 11) {
+            throw std::invalid_argument("ChaveCPF: CPF deve ter 11 digitos: '" + std::string(texto, tamanho) + "'.");
+        }
+        return resultado;
+    }
+};
+
+// Imprime a chave no formato "111.111.111-11".
+inline std::ostream& operator<<(std::ostream& saida, const ChaveCPF& chave) {
+    return saida << chave.formatar();
+}
+
+#endif // CHAVE_CPF_H
@@ -0,0 +1,42 @@
+#ifndef CHAVE_SECUNDARIA_H
+#define CHAVE_SECUNDARIA_H
+
+#include <iostream>
+#include <string>
+
+// Chave dos índices secundários (nome, data de nascimento...), em que vários registros
+// podem ter o mesmo valor. A ABB não aceita chaves repetidas, então a posição na EDL
+// entra na chave como desempate: a ordem é (valor, posição), cada registro tem uma chave
+// única, e todas as posições de um mesmo valor ficam contíguas no percurso em ordem.
+// Com isso, "todas as posições do valor v" é o intervalo [(v, menor int), (v, maior int)].
+class ChaveSecundaria {
+private:
+    std::string valor; // Valor do campo indexado (já normalizado pelo extrator do índice)
+    int posicao;       // Posição do registro na EDL (desempate)
+
+public:
+    ChaveSecundaria() : valor(), posicao(-1) {}
+    ChaveSecundaria(const std::string& valor, int posicao) : valor(valor), posicao(posicao) {}
+
+    const std::string& getValor() const { return valor; }
+    int getPosicao() const { return posicao; }
+
+    bool operator<(const ChaveSecundaria& outra) const {
+        int comparacao = valor.compare(outra.valor);
+        return comparacao < 0 || (comparacao == 0 && posicao < outra.posicao);
+    }
+    bool operator==(const ChaveSecundaria& outra) const {
+        return posicao == outra.posicao && valor == outra.valor;
+    }
+    bool operator!=(const ChaveSecundaria& outra) const { return !(*this == outra); }
+    bool operator>(const ChaveSecundaria& outra) const { return outra < *this; }
+    bool operator<=(const ChaveSecundaria& outra) const { return !(outra < *this); }
+    bool operator>=(const ChaveSecundaria& outra) const { return !(*this < outra); }
+};
+
+// Imprime a chave como "valor#posição".
+inline std::ostream& operator<<(std::ostream& saida, const ChaveSecundaria& chave) {
+    return saida << chave.getValor() << '#' << chave.getPosicao();
+}
+
+#endif // CHAVE_SECUNDARIA_H
@@ -3,55 +3,59 @@
 
 #include <string>
 #include <iostream>
+#include "abb/ChaveCPF.h"
 
 // Classe que representa uma entrada em um nó da Árvore Binária de Busca (ABB).
-// Contém a chave de ordenação (CPF) e a posição correspondente na EDL.
+// Contém a chave de ordenação e a posição correspondente na EDL.
 // Esta classe é leve e usada para as comparações na ABB.
-class EntradaIndice {
+// O tipo da chave é um parâmetro: o índice de CPFs usa ChaveCPF (inteiro de 64 bits),
+// e std::string continua disponível para chaves que não são CPF.
+template <typename Chave>
+class EntradaIndiceGenerica {
 private:
-    std::string chave; // CPF: a chave de ordenação usada pela ABB
-    int posicaoEDL;    // Índice na Estrutura de Dados Linear (EDL) onde o Registro completo está
+    Chave chave;    // A chave de ordenação usada pela ABB
+    int posicaoEDL; // Índice na Estrutura de Dados Linear (EDL) onde o Registro completo está
 
 public:
     // Construtor padrão: inicializa com valores vazios/nulos.
-    EntradaIndice() : chave(""), posicaoEDL(-1) {}
+    EntradaIndiceGenerica() : chave(), posicaoEDL(-1) {}
 
     // Construtor completo: para criar uma entrada com chave e posição.
-    EntradaIndice(const std::string& chave, int posicaoEDL)
+    EntradaIndiceGenerica(const Chave& chave, int posicaoEDL)
         : chave(chave), posicaoEDL(posicaoEDL) {}
 
     // Construtor para busca: permite criar uma EntradaIndice apenas com a chave para comparações.
-    explicit EntradaIndice(const std::string& chave)
+    explicit EntradaIndiceGenerica(const Chave& chave)
         : chave(chave), posicaoEDL(-1) {}
 
-    // Getters para acessar a chave e a posição.
-    std::string getChave() const { return chave; }
+    // Getters para acessar a chave (por referência, sem cópia) e a posição.
+    const Chave& getChave() const { return chave; }
     int getPosicaoEDL() const { return posicaoEDL; }
 
     // Sobrecargas dos operadores de comparação.
-    // Essenciais para a ABB determinar a ordem dos nós, baseadas na 'chave' (CPF).
-    bool operator<(const EntradaIndice& outra) const {
+    // Essenciais para a ABB determinar a ordem dos nós, baseadas na 'chave'.
+    bool operator<(const EntradaIndiceGenerica& outra) const {
         return chave < outra.chave;
     }
 
-    bool operator==(const EntradaIndice& outra) const {
+    bool operator==(const EntradaIndiceGenerica& outra) const {
         return chave == outra.chave;
     }
 
-    bool operator!=(const EntradaIndice& outra) const {
+    bool operator!=(const EntradaIndiceGenerica& outra) const {
         return chave != outra.chave;
     }
 
-    bool operator>(const EntradaIndice& outra) const {
-        return chave > outra.chave;
+    bool operator>(const EntradaIndiceGenerica& outra) const {
+        return outra.chave < chave;
     }
 
-    bool operator<=(const EntradaIndice& outra) const {
-        return chave <= outra.chave;
+    bool operator<=(const EntradaIndiceGenerica& outra) const {
+        return !(outra.chave < chave);
     }
 
-    bool operator>=(const EntradaIndice& outra) const {
-        return chave >= outra.chave;
+    bool operator>=(const EntradaIndiceGenerica& outra) const {
+        return !(chave < outra.chave);
     }
 
     // Imprime a chave e a posição da entrada do índice no console.
@@ -60,4 +64,10 @@ public:
     }
 };
 
-#endif // ENTRADA_INDICE_H
\ No newline at end of file
+// Entrada do índice principal: CPF empacotado em 64 bits.
+typedef EntradaIndiceGenerica<ChaveCPF> EntradaIndice;
+
+// Entrada com chave textual, para índices sobre campos que não são CPF.
+typedef EntradaIndiceGenerica<std::string> EntradaIndiceTexto;
+
+#endif // ENTRADA_INDICE_H
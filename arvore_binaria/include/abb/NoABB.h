@@ -1,21 +1,32 @@
 #ifndef NO_ABB_H
 #define NO_ABB_H
 
+#include <cstdint>
+#include "abb/ArenaNos.h"      // Para INDICE_NULO
 #include "abb/EntradaIndice.h" // Inclui a definição da classe EntradaIndice
 
 // Classe que representa um nó individual em uma Árvore Binária de Busca (ABB).
-// Cada nó armazena uma EntradaIndice e ponteiros para seus filhos.
-class NoABB {
+// Cada nó armazena uma EntradaIndice, os índices de seus filhos e a altura e o tamanho da subárvore.
+// Os nós vivem em uma ArenaNos, por isso os filhos são índices de 32 bits na arena
+// (e não ponteiros): o nó fica menor e a árvore pode ser copiada bloco a bloco.
+template <typename Chave>
+class NoABBGenerico {
 public:
-    EntradaIndice dado; // O dado (EntradaIndice) armazenado neste nó
-    NoABB* esq;         // Ponteiro para o filho esquerdo
-    NoABB* dir;         // Ponteiro para o filho direito
+    EntradaIndiceGenerica<Chave> dado; // O dado (EntradaIndice) armazenado neste nó
+    uint32_t esq;                      // Índice do filho esquerdo na arena (INDICE_NULO se não houver)
+    uint32_t dir;                      // Índice do filho direito na arena (INDICE_NULO se não houver)
+    int altura;                        // Altura da subárvore enraizada neste nó (folha = 1), usada pelo balanceamento AVL
+    uint32_t tamanho;                  // Número de nós da subárvore enraizada neste nó (folha = 1), usado nas consultas por ordem
 
-    // Construtor: inicializa o nó com uma EntradaIndice e filhos nulos.
-    NoABB(const EntradaIndice& entrada) : dado(entrada), esq(nullptr), dir(nullptr) {}
+    // Construtor padrão: usado pela arena ao criar um bloco de nós.
+    NoABBGenerico() : dado(), esq(INDICE_NULO), dir(INDICE_NULO), altura(1), tamanho(1) {}
 
-    // Destrutor padrão: a liberação de memória dos nós filhos é gerenciada pela classe ABB.
-    ~NoABB() = default;
+    // Construtor: inicializa o nó com uma EntradaIndice, sem filhos e com altura e tamanho de folha.
+    NoABBGenerico(const EntradaIndiceGenerica<Chave>& entrada)
+        : dado(entrada), esq(INDICE_NULO), dir(INDICE_NULO), altura(1), tamanho(1) {}
 };
 
-#endif // NO_ABB_H
\ No newline at end of file
+// Nó do índice principal, com chave CPF.
+typedef NoABBGenerico<ChaveCPF> NoABB;
+
+#endif // NO_ABB_H
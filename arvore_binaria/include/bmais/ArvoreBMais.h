@@ -0,0 +1,80 @@
+#ifndef ARVORE_B_MAIS_H
+#define ARVORE_B_MAIS_H
+
+#include "bmais/NoBMais.h"
+#include "abb/EntradaIndice.h"
+#include <vector>
+#include <utility>
+
+// Índice alternativo à ABB, implementado como uma Árvore B+.
+// Cada nó agrupa dezenas de chaves (ChaveCPF) armazenadas inline, sem std::string no heap,
+// e as folhas são encadeadas para o percurso em ordem. Oferece a mesma semântica
+// da ABB para inserção, remoção, busca de posição e percurso em ordem.
+class ArvoreBMais {
+private:
+    NoBMais* raiz;      // Raiz da árvore (nullptr quando vazia)
+    size_t quantidade;  // Número de entradas armazenadas
+    int altura;         // Número de níveis (0 para árvore vazia, 1 quando a raiz é folha)
+
+    // Caminho percorrido da raiz até uma folha: (nó interno, índice do filho seguido).
+    typedef std::vector<std::pair<NoInternoBMais*, int> > Caminho;
+
+    // Desce da raiz até a folha onde a chave está (ou deveria estar), registrando o caminho.
+    NoFolhaBMais* descer(const ChaveBMais& chave, Caminho* caminho) const;
+
+    // Índice do filho a seguir em um nó interno: quantidade de separadores <= chave.
+    static int indiceFilho(const NoInternoBMais* no, const ChaveBMais& chave);
+
+    // Posição da primeira chave >= 'chave' em uma folha.
+    static int indiceNaFolha(const NoFolhaBMais* folha, const ChaveBMais& chave);
+
+    // Insere o separador e o novo filho direito resultantes de uma divisão,
+    // subindo pelo caminho e dividindo os nós internos cheios.
+    void inserirNoPai(Caminho& caminho, ChaveBMais separador, NoBMais* novoFilho);
+
+    // Corrige um nó com ocupação abaixo do mínimo, pegando emprestado de um irmão
+    // ou fundindo-se a ele. Retorna true se o pai perdeu uma chave (fusão).
+    bool corrigirOcupacao(NoBMais* no, NoInternoBMais* pai, int indice);
+
+    // Libera todos os nós sem recursão.
+    void destruir();
+
+public:
+    // Construtor padrão: cria uma árvore vazia.
+    ArvoreBMais();
+
+    // Destrutor: libera todos os nós.
+    ~ArvoreBMais();
+
+    // A árvore gerencia nós brutos; a cópia não é suportada.
+    ArvoreBMais(const ArvoreBMais&) = delete;
+    ArvoreBMais& operator=(const ArvoreBMais&) = delete;
+
+    // Insere uma nova EntradaIndice. Chaves duplicadas são recusadas com mensagem de erro.
+    void inserir(const EntradaIndice& novaEntrada);
+
+    // Carga em lote: descarta o conteúdo atual e monta a árvore de baixo para cima, folha a
+    // folha, em O(n) se a entrada já estiver ordenada por chave ('jaOrdenadas'). Chaves
+    // repetidas são recusadas com mensagem de erro; permanece a de menor posição.
+    void carregarEmLote(std::vector<EntradaIndice> entradas, bool jaOrdenadas);
+
+    // Remove a entrada com a chave informada. Informa erro se a chave não existir.
+    void remover(const ChaveBMais& chaveRemover);
+
+    // Busca a posição na EDL associada à chave. Retorna -1 se não existir.
+    int buscarPosicao(const ChaveBMais& chaveBusca) const;
+
+    // Percurso em ordem: percorre a lista encadeada de folhas, imprimindo as entradas.
+    void emOrdem() const;
+
+    // Deleta todos os nós, tornando a árvore vazia.
+    void deletarArvore();
+
+    // Número de entradas armazenadas.
+    size_t getTamanho() const;
+
+    // Número de níveis da árvore.
+    int getAltura() const;
+};
+
+#endif // ARVORE_B_MAIS_H
@@ -0,0 +1,55 @@
+#ifndef NO_B_MAIS_H
+#define NO_B_MAIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "abb/ChaveCPF.h"
+
+// Tipo de chave armazenado nos nós da Árvore B+: o CPF empacotado em 64 bits,
+// guardado inline no nó (sem alocação no heap).
+typedef ChaveCPF ChaveBMais;
+
+// Tamanho alvo de cada nó, em bytes. Um nó ocupa poucas linhas de cache (64 bytes),
+// de modo que uma busca toca O(log_B n) nós em vez de O(log2 n) nós espalhados na memória.
+const size_t TAM_NO_BMAIS = 256;
+
+// Cabeçalho comum aos dois tipos de nó.
+struct NoBMais {
+    bool folha;           // true para NoFolhaBMais, false para NoInternoBMais
+    uint16_t quantidade;  // Número de chaves ocupadas no nó
+
+    explicit NoBMais(bool folha) : folha(folha), quantidade(0) {}
+};
+
+// Capacidades calculadas a partir do tamanho alvo do nó.
+// Folha: chave + posição na EDL por entrada, mais o ponteiro para a próxima folha.
+const size_t MAX_CHAVES_FOLHA =
+    (TAM_NO_BMAIS - sizeof(NoBMais) - sizeof(void*)) / (sizeof(ChaveBMais) + sizeof(int));
+// Nó interno: n chaves separadoras e n + 1 ponteiros para filhos.
+const size_t MAX_CHAVES_INTERNO =
+    (TAM_NO_BMAIS - sizeof(NoBMais) - sizeof(void*)) / (sizeof(ChaveBMais) + sizeof(void*));
+
+// Ocupação mínima de um nó (exceto a raiz) após remoções.
+const size_t MIN_CHAVES_FOLHA = MAX_CHAVES_FOLHA / 2;
+const size_t MIN_CHAVES_INTERNO = MAX_CHAVES_INTERNO / 2;
+
+// Nó interno: as chaves apenas orientam a descida.
+// A subárvore filhos[i] contém chaves < chaves[i]; filhos[i + 1] contém chaves >= chaves[i].
+struct NoInternoBMais : public NoBMais {
+    ChaveBMais chaves[MAX_CHAVES_INTERNO];
+    NoBMais* filhos[MAX_CHAVES_INTERNO + 1];
+
+    NoInternoBMais() : NoBMais(false) {}
+};
+
+// Nó folha: guarda as entradas (chave, posição na EDL) em ordem crescente
+// e aponta para a folha seguinte, permitindo o percurso em ordem sem subir na árvore.
+struct NoFolhaBMais : public NoBMais {
+    ChaveBMais chaves[MAX_CHAVES_FOLHA];
+    int posicoes[MAX_CHAVES_FOLHA];
+    NoFolhaBMais* proxima;
+
+    NoFolhaBMais() : NoBMais(true), proxima(nullptr) {}
+};
+
+#endif // NO_B_MAIS_H
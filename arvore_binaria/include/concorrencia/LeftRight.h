@@ -0,0 +1,139 @@
+#ifndef LEFT_RIGHT_H
+#define LEFT_RIGHT_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread> // Para std::this_thread::yield
+#include <utility>
+
+// Controle de concorrência "Left-Right" (Ramalho e Correia): muitos leitores e um escritor
+// por vez, sem que as leituras jamais bloqueiem ou esperem o escritor.
+//
+// A estrutura protegida é mantida em duas instâncias idênticas. Os leitores usam sempre a
+// instância "ativa"; o escritor aplica a alteração na outra, troca a instância ativa, espera
+// os leitores que ainda estavam na antiga saírem e então repete a alteração nela.
+// Assim nenhum leitor vê uma alteração pela metade e nenhum nó é liberado enquanto
+// alguém ainda pode lê-lo (o problema que a recuperação por épocas resolveria).
+//
+// Custos: a memória é dobrada e cada escrita é aplicada duas vezes. Por isso a operação
+// passada a 'escrever' deve ser determinística (produzir o mesmo efeito nas duas instâncias).
+// As escritas são serializadas por um mutex, que nunca é tomado pelos leitores.
+template <typename T>
+class LeftRight {
+public:
+    // Número de contadores do indicador de leitura. Cada thread usa sempre o mesmo contador,
+    // e leitores em contadores diferentes não disputam a mesma linha de cache.
+    static const size_t CONTADORES = 64;
+
+private:
+    // Contador de leitores em andamento, ocupando sozinho uma linha de cache.
+    struct alignas(64) ContadorLeitores {
+        std::atomic<long> leitores;
+        ContadorLeitores() : leitores(0) {}
+    };
+
+    // Indicador de leitura: quantos leitores entraram por este lado e ainda não saíram.
+    struct IndicadorLeitura {
+        ContadorLeitores contadores[CONTADORES];
+
+        void chegar(size_t slot) { contadores[slot].leitores.fetch_add(1); }
+        void sair(size_t slot) { contadores[slot].leitores.fetch_sub(1); }
+
+        bool vazio() const {
+            for (size_t i = 0; i < CONTADORES; ++i) {
+                if (contadores[i].leitores.load() != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // Marca a saída do leitor mesmo que a função de leitura lance uma exceção.
+    struct SaidaLeitor {
+        IndicadorLeitura& indicador;
+        size_t slot;
+        ~SaidaLeitor() { indicador.sair(slot); }
+    };
+
+    T instancias[2];
+    std::atomic<int> ativa;           // Instância lida pelos novos leitores
+    std::atomic<int> versaoIndicador; // Indicador em que os novos leitores se registram
+    mutable IndicadorLeitura indicadores[2];
+    std::mutex escrita;               // Serializa os escritores
+
+    // Contador usado pela thread atual: distribuído em rodízio na primeira leitura da thread.
+    static size_t slotDaThread() {
+        static std::atomic<size_t> proximo(0);
+        thread_local size_t slot = proximo.fetch_add(1) % CONTADORES;
+        return slot;
+    }
+
+    // Troca o indicador dos novos leitores e espera esvaziar os dois: depois disso,
+    // nenhum leitor que começou antes da troca de instância ainda está lendo.
+    void esperarLeitores() {
+        int atual = versaoIndicador.load();
+        int proxima = 1 - atual;
+        while (!indicadores[proxima].vazio()) {
+            std::this_thread::yield();
+        }
+        versaoIndicador.store(proxima);
+        while (!indicadores[atual].vazio()) {
+            std::this_thread::yield();
+        }
+    }
+
+public:
+    // As duas instâncias começam como cópias de 'inicial'.
+    explicit LeftRight(const T& inicial = T()) : ativa(0), versaoIndicador(0) {
+        instancias[0] = inicial;
+        instancias[1] = inicial;
+    }
+
+    LeftRight(const LeftRight&) = delete;
+    LeftRight& operator=(const LeftRight&) = delete;
+
+    // Executa 'ler(const T&)' sobre a instância ativa e devolve o seu resultado.
+    // Nunca bloqueia: custa dois incrementos atômicos em um contador quase sempre exclusivo.
+    // Referências para dentro de T não devem escapar da função, pois a instância
+    // volta a ser alterada pelo escritor assim que o leitor sai.
+    template <typename Leitura>
+    auto ler(Leitura ler) const -> decltype(ler(std::declval<const T&>())) {
+        size_t slot = slotDaThread();
+        IndicadorLeitura& indicador = indicadores[versaoIndicador.load()];
+        indicador.chegar(slot);
+        SaidaLeitor saida{indicador, slot};
+        return ler(static_cast<const T&>(instancias[ativa.load()]));
+    }
+
+    // Aplica 'alterar(T&)' às duas instâncias, como descrito acima. Só um escritor
+    // executa por vez. Resultados da alteração podem ser capturados pela própria função,
+    // já que as duas aplicações produzem o mesmo efeito.
+    // Se a primeira aplicação lançar uma exceção, a instância inativa é restaurada a partir
+    // da ativa (que os leitores continuam usando) e a exceção é propagada.
+    // Se a segunda lançar, a alteração já está visível aos leitores: a instância inativa
+    // recebe uma cópia da ativa, para que as duas voltem a ser iguais, e a exceção é
+    // propagada.
+    template <typename Alteracao>
+    void escrever(Alteracao alterar) {
+        std::lock_guard<std::mutex> trava(escrita);
+        int atual = ativa.load();
+        try {
+            alterar(instancias[1 - atual]);
+        } catch (...) {
+            instancias[1 - atual] = instancias[atual];
+            throw;
+        }
+        ativa.store(1 - atual); // Novos leitores passam para a instância já alterada
+        esperarLeitores();      // Leitores antigos saem da instância desatualizada
+        try {
+            alterar(instancias[atual]);
+        } catch (...) {
+            instancias[atual] = instancias[1 - atual];
+            throw;
+        }
+    }
+};
+
+#endif // LEFT_RIGHT_H
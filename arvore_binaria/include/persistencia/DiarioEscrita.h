@@ -0,0 +1,104 @@
+#ifndef DIARIO_ESCRITA_H
+#define DIARIO_ESCRITA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "Registro.h"
+
+// Tipos de operação registrados no diário.
+enum class TipoOperacao : uint8_t {
+    INSERCAO = 1,
+    REMOCAO = 2
+};
+
+// Uma operação lida do diário. Na inserção, 'registro' traz o registro completo;
+// na remoção, apenas 'cpf' é preenchido.
+struct OperacaoDiario {
+    uint64_t numero; // Número de sequência, crescente ao longo da vida da base
+    TipoOperacao tipo;
+    Registro registro;
+    std::string cpf;
+};
+
+// Diário de escrita antecipada ("write-ahead log"): arquivo só de acréscimos com as
+// inserções e remoções da base, gravado antes de a operação ser considerada confirmada.
+// Cada entrada tem o formato
+//   [tamanho do corpo: 4 bytes][soma FNV-1a do corpo: 4 bytes][corpo]
+//   corpo = [número: 8 bytes][tipo: 1 byte][campos em texto com tamanho de 16 bits]
+// Uma entrada gravada pela metade (queda no meio de uma gravação) tem a soma errada ou
+// termina antes do fim do arquivo: ao abrir, ela e tudo o que vem depois são descartados.
+//
+// Confirmação em grupo: 'registrar...' apenas acrescenta a entrada a um buffer em memória;
+// 'confirmar' grava o buffer inteiro com uma única chamada a write e uma única fdatasync.
+// Quanto mais operações por confirmação, menor o custo da sincronização por operação,
+// ao custo de perder as operações ainda não confirmadas em caso de queda.
+// Não é seguro para uso simultâneo por várias threads.
+class DiarioEscrita {
+public:
+    typedef std::function<void(const OperacaoDiario& operacao)> Visitante;
+
+    // Abre (ou cria) o diário em 'caminho' e descarta uma eventual entrada incompleta no final.
+    // Lança std::runtime_error se não for possível abrir o arquivo.
+    explicit DiarioEscrita(const std::string& caminho);
+
+    // Confirma as operações pendentes e fecha o arquivo.
+    ~DiarioEscrita();
+
+    DiarioEscrita(const DiarioEscrita&) = delete;
+    DiarioEscrita& operator=(const DiarioEscrita&) = delete;
+
+    // Acrescentam uma operação ao buffer e retornam o seu número de sequência.
+    // A operação só é durável depois de 'confirmar'.
+    // Lançam std::length_error se algum campo tiver mais de 65535 bytes.
+    uint64_t registrarInsercao(const Registro& registro);
+    uint64_t registrarRemocao(const std::string& cpf);
+
+    // Grava as operações pendentes e sincroniza o arquivo com o disco (fdatasync).
+    // Não faz nada se não houver pendentes. Lança std::runtime_error em caso de erro de E/S.
+    void confirmar();
+
+    // Chama 'visitar' para cada operação válida gravada no arquivo, em ordem.
+    // As operações ainda pendentes no buffer não são visitadas.
+    void percorrer(const Visitante& visitar) const;
+
+    // Esvazia o arquivo (depois de um checkpoint, que já contém todas as operações).
+    // As pendentes são confirmadas antes; a numeração continua de onde estava.
+    void reiniciar();
+
+    // Garante que o próximo número de sequência seja maior que 'numero'
+    // (ex.: o último número já incluído no checkpoint, quando o diário está vazio).
+    void avancarNumeracao(uint64_t numero);
+
+    // Último número de sequência atribuído (0 se nenhum).
+    uint64_t getUltimoNumero() const;
+
+    // Operações no buffer, ainda não confirmadas.
+    size_t getPendentes() const;
+
+    // Número de sincronizações com o disco feitas por 'confirmar' (para medir o agrupamento).
+    size_t getSincronizacoes() const;
+
+    // Bytes descartados no final do arquivo ao abrir (entrada incompleta ou corrompida).
+    size_t getBytesDescartados() const;
+
+private:
+    std::string caminho;
+    int descritor;
+    size_t bytesValidos;     // Tamanho do arquivo até a última entrada confirmada
+    std::string buffer;      // Entradas ainda não gravadas
+    size_t pendentes;
+    uint64_t ultimoNumero;
+    size_t sincronizacoes;
+    size_t bytesDescartados;
+
+    // Acrescenta ao buffer o cabeçalho e o corpo já montado.
+    void acrescentarEntrada(const std::string& corpo);
+
+    // Lê o arquivo inteiro e chama 'visitar' (se houver) para cada entrada válida.
+    // Retorna o tamanho, em bytes, da parte válida do arquivo.
+    size_t lerEntradas(const Visitante* visitar, uint64_t& ultimo) const;
+};
+
+#endif // DIARIO_ESCRITA_H
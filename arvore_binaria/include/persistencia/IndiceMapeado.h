@@ -0,0 +1,67 @@
+#ifndef INDICE_MAPEADO_H
+#define INDICE_MAPEADO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "abb/ABB.h"
+
+// Fotografia ("snapshot") do índice de CPFs em disco, na forma de vetor ordenado:
+//   * cabeçalho de 64 bytes (assinatura "ABBIDX01", versão, quantidade de entradas);
+//   * as n chaves (valor numérico do CPF, 8 bytes cada), em ordem crescente;
+//   * as n posições na EDL (4 bytes cada), na mesma ordem das chaves.
+// Chaves e posições ficam em vetores separados para que a busca binária percorra
+// só as chaves (8 por linha de cache). O arquivo ocupa 12 bytes por entrada e pode ser
+// usado direto do disco, por mmap, sem montar a ABB.
+
+// Grava o índice em 'caminho' (um arquivo temporário renomeado no final, para nunca deixar
+// uma fotografia pela metade; o diretório é sincronizado depois da renomeação).
+// Lança std::runtime_error em caso de erro de E/S.
+void salvarIndice(const ABB& indice, const std::string& caminho);
+
+// Recarrega a ABB a partir da fotografia em O(n): as entradas já estão em ordem, então a
+// carga em lote monta a árvore balanceada sem comparar nem reordenar chaves.
+// O conteúdo anterior do índice é descartado. Lança std::runtime_error (sem alterar o
+// índice) se o arquivo não existir, não estiver no formato esperado, tiver uma chave que
+// não seja um CPF ou uma posição negativa, ou se as chaves não estiverem em ordem
+// estritamente crescente.
+void carregarIndice(ABB& indice, const std::string& caminho);
+
+// Fotografia do índice aberta por mmap, só para consultas. Abrir custa o mapeamento e a
+// validação do cabeçalho (independe do número de chaves); o sistema operacional traz as
+// páginas do disco conforme as buscas as tocam. Requer um sistema POSIX.
+class IndiceMapeado {
+public:
+    // Lança std::runtime_error se o arquivo não existir ou não estiver no formato esperado.
+    explicit IndiceMapeado(const std::string& caminho);
+    ~IndiceMapeado();
+
+    IndiceMapeado(const IndiceMapeado&) = delete;
+    IndiceMapeado& operator=(const IndiceMapeado&) = delete;
+
+    // Busca binária: posição na EDL do CPF, ou -1 se não houver. O(log n).
+    int buscarPosicao(const ChaveCPF& cpf) const;
+
+    // Posições na EDL dos CPFs em [inicio, fim], em ordem de CPF.
+    std::vector<int> buscarIntervalo(const ChaveCPF& inicio, const ChaveCPF& fim) const;
+
+    // Número de entradas.
+    size_t getTamanho() const { return quantidade; }
+
+    // Entrada na ordem i (0 <= i < getTamanho()), sem validação do índice. Lança
+    // std::invalid_argument se a chave gravada tiver mais de 11 dígitos.
+    EntradaIndice getEntrada(size_t i) const {
+        return EntradaIndice(ChaveCPF::deValor(chaves[i]), posicoes[i]);
+    }
+
+private:
+    std::string caminho;
+    void* mapa;
+    size_t bytesMapeados;
+    size_t quantidade;
+    const uint64_t* chaves;
+    const int32_t* posicoes;
+};
+
+#endif // INDICE_MAPEADO_H
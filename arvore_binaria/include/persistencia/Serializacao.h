@@ -0,0 +1,108 @@
+#ifndef SERIALIZACAO_H
+#define SERIALIZACAO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // Para std::memcpy
+#include <stdexcept> // Para std::length_error, std::runtime_error
+#include <string>
+#include <cerrno>
+#include <fcntl.h>   // Para open
+#include <unistd.h>  // Para write, fsync, close
+
+// Rotinas de baixo nível compartilhadas pelos formatos binários da base (diário de escrita
+// e checkpoint). Inteiros são gravados na ordem de bytes da máquina: os arquivos não são
+// portáveis entre arquiteturas, como os da EDLArquivo.
+
+// Soma de verificação FNV-1a de 32 bits: detecta registros corrompidos ou gravados pela metade.
+inline uint32_t somaVerificacao(const char* dados, size_t tamanho) {
+    uint32_t soma = 2166136261u;
+    for (size_t i = 0; i < tamanho; ++i) {
+        soma ^= static_cast<unsigned char>(dados[i]);
+        soma *= 16777619u;
+    }
+    return soma;
+}
+
+// Acrescenta um inteiro (ou outro valor trivialmente copiável) ao final do buffer.
+template <typename T>
+void acrescentarValor(std::string& buffer, T valor) {
+    buffer.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+// Acrescenta um texto precedido pelo seu tamanho (16 bits).
+// Lança std::length_error se o texto tiver mais de 65535 bytes.
+inline void acrescentarTexto(std::string& buffer, const std::string& texto) {
+    if (texto.size() > UINT16_MAX) {
+        throw std::length_error("Serializacao: texto com mais de 65535 bytes.");
+    }
+    acrescentarValor(buffer, static_cast<uint16_t>(texto.size()));
+    buffer.append(texto);
+}
+
+// Leitura sequencial de um bloco de bytes. Cada 'ler' retorna false, sem avançar,
+// se o bloco terminar antes do valor (registro truncado).
+class LeitorBinario {
+private:
+    const char* atual;
+    const char* fim;
+
+public:
+    LeitorBinario(const char* inicio, size_t tamanho) : atual(inicio), fim(inicio + tamanho) {}
+
+    template <typename T>
+    bool ler(T& valor) {
+        if (static_cast<size_t>(fim - atual) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&valor, atual, sizeof(T));
+        atual += sizeof(T);
+        return true;
+    }
+
+    bool lerTexto(std::string& texto) {
+        uint16_t tamanho = 0;
+        const char* inicio = atual;
+        if (!ler(tamanho) || static_cast<size_t>(fim - atual) < tamanho) {
+            atual = inicio;
+            return false;
+        }
+        texto.assign(atual, tamanho);
+        atual += tamanho;
+        return true;
+    }
+
+    size_t restantes() const { return static_cast<size_t>(fim - atual); }
+};
+
+// Grava todo o buffer no descritor, repetindo após gravações parciais e interrupções.
+// Lança std::runtime_error em caso de erro de E/S.
+inline void gravarTudo(int descritor, const char* dados, size_t tamanho, const std::string& caminho) {
+    while (tamanho > 0) {
+        ssize_t gravados = ::write(descritor, dados, tamanho);
+        if (gravados < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Serializacao: falha ao gravar '" + caminho + "'.");
+        }
+        dados += gravados;
+        tamanho -= static_cast<size_t>(gravados);
+    }
+}
+
+// Sincroniza o diretório com o disco, para que uma criação ou renomeação de arquivo
+// dentro dele sobreviva a uma queda de energia.
+inline void sincronizarDiretorio(const std::string& diretorio) {
+    int descritor = ::open(diretorio.c_str(), O_RDONLY);
+    if (descritor < 0) {
+        throw std::runtime_error("Serializacao: nao foi possivel abrir o diretorio '" + diretorio + "'.");
+    }
+    int resultado = ::fsync(descritor);
+    ::close(descritor);
+    if (resultado != 0) {
+        throw std::runtime_error("Serializacao: falha ao sincronizar o diretorio '" + diretorio + "'.");
+    }
+}
+
+#endif // SERIALIZACAO_H
@@ -1,17 +1,134 @@
 #include "ABB.h"
 #include <iostream>
 #include <algorithm> // Para uso futuro de std::min/max, se necessário em algoritmos mais complexos
-#include <functional> // Para std::function, se usado em lambdas ou callbacks
+#include <functional> // Para std::function (visitantes dos percursos)
+#include <limits>     // Para std::numeric_limits (prefixo das chaves secundárias)
+#include <stdexcept>  // Para std::out_of_range
+#include <thread>     // Para a ordenação paralela da carga em lote
+
+// Pede ao processador que comece a trazer 'endereco' para o cache (sem esperar).
+// Em compiladores sem a extensão, vira uma instrução vazia.
+#if defined(__GNUC__)
+#define PREFETCH_LEITURA(endereco) __builtin_prefetch((endereco), 0, 3)
+#else
+#define PREFETCH_LEITURA(endereco) ((void)0)
+#endif
+
+namespace {
+
+// Número de buscas que descem a árvore juntas em buscarPosicoes. Deve ser grande
+// o suficiente para esconder a latência da memória, mas caber nos buffers de faltas de cache.
+const size_t BUSCAS_POR_GRUPO = 16;
+
+// Ordena as entradas por chave (e, em caso de empate, por posição na EDL) usando
+// várias threads: cada thread ordena uma fatia e as fatias são intercaladas aos pares.
+template <typename Entrada>
+void ordenarParalelo(std::vector<Entrada>& entradas) {
+    // Mesma chave: a entrada de menor posição vem primeiro e é a que permanece no índice.
+    auto menor = [](const Entrada& a, const Entrada& b) {
+        return a < b || (!(b < a) && a.getPosicaoEDL() < b.getPosicaoEDL());
+    };
+
+    const size_t MIN_POR_THREAD = 1 << 16; // Abaixo disso, criar threads não compensa
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<size_t>(1, entradas.size() / MIN_POR_THREAD));
+    if (threads == 1) {
+        std::sort(entradas.begin(), entradas.end(), menor);
+        return;
+    }
+
+    // Limites das fatias: fatia i = [limites[i], limites[i + 1]).
+    std::vector<size_t> limites;
+    for (size_t i = 0; i <= threads; ++i) {
+        limites.push_back(entradas.size() * i / threads);
+    }
+
+    std::vector<std::thread> trabalhadores;
+    for (size_t i = 0; i < threads; ++i) {
+        trabalhadores.push_back(std::thread([&, i]() {
+            std::sort(entradas.begin() + limites[i], entradas.begin() + limites[i + 1], menor);
+        }));
+    }
+    for (size_t i = 0; i < trabalhadores.size(); ++i) {
+        trabalhadores[i].join();
+    }
+
+    // Intercala as fatias vizinhas, dobrando o tamanho a cada rodada.
+    for (size_t passo = 1; passo < threads; passo *= 2) {
+        trabalhadores.clear();
+        for (size_t i = 0; i + passo < threads; i += 2 * passo) {
+            size_t inicio = limites[i];
+            size_t meio = limites[i + passo];
+            size_t fim = limites[std::min(i + 2 * passo, threads)];
+            trabalhadores.push_back(std::thread([&entradas, inicio, meio, fim, menor]() {
+                std::inplace_merge(entradas.begin() + inicio, entradas.begin() + meio,
+                                   entradas.begin() + fim, menor);
+            }));
+        }
+        for (size_t i = 0; i < trabalhadores.size(); ++i) {
+            trabalhadores[i].join();
+        }
+    }
+}
+
+// Faixa de chaves que começam com um prefixo: a busca parte de 'menor' e
+// segue enquanto 'contem' for verdadeiro (as chaves do prefixo são contíguas na ordem).
+template <typename Chave>
+struct FaixaPrefixo;
+
+// CPF: o prefixo vira um intervalo numérico fechado.
+template <>
+struct FaixaPrefixo<ChaveCPF> {
+    ChaveCPF menor;
+    ChaveCPF maior;
+
+    explicit FaixaPrefixo(const std::string& prefixo) {
+        ChaveCPF::faixaDoPrefixo(prefixo, menor, maior);
+    }
+
+    bool contem(const ChaveCPF& chave) const { return chave <= maior; }
+};
+
+// Texto: todas as chaves com o prefixo são >= ao próprio prefixo.
+template <>
+struct FaixaPrefixo<std::string> {
+    std::string menor;
+
+    explicit FaixaPrefixo(const std::string& prefixo) : menor(prefixo) {}
+
+    bool contem(const std::string& chave) const {
+        return chave.compare(0, menor.size(), menor) == 0;
+    }
+};
+
+// Chave secundária: o prefixo vale para o valor; a menor posição possível vem antes
+// de todas as chaves cujo valor é igual ao próprio prefixo.
+template <>
+struct FaixaPrefixo<ChaveSecundaria> {
+    ChaveSecundaria menor;
+
+    explicit FaixaPrefixo(const std::string& prefixo)
+        : menor(prefixo, std::numeric_limits<int>::min()) {}
+
+    bool contem(const ChaveSecundaria& chave) const {
+        return chave.getValor().compare(0, menor.getValor().size(), menor.getValor()) == 0;
+    }
+};
+
+} // namespace
 
 // 1. Construtores
 
-// Construtor padrão: Inicializa a raiz como nullptr, criando uma árvore vazia.
-ABB::ABB() : raiz(nullptr) {
+// Construtor padrão: Inicializa a raiz como INDICE_NULO, criando uma árvore vazia.
+template <typename Chave>
+ABBGenerica<Chave>::ABBGenerica(TipoBalanceamento tipo) : raiz(INDICE_NULO), balanceamento(tipo), quantidade(0) {
     // Apenas para depuração: std::cout << "ABB vazia criada." << std::endl;
 }
 
 // Construtor a partir de initializer_list: Popula a árvore com os elementos da lista.
-ABB::ABB(std::initializer_list<EntradaIndice> lista) : raiz(nullptr) {
+template <typename Chave>
+ABBGenerica<Chave>::ABBGenerica(std::initializer_list<Entrada> lista, TipoBalanceamento tipo)
+    : raiz(INDICE_NULO), balanceamento(tipo), quantidade(0) {
     // Apenas para depuração: std::cout << "ABB sendo criada a partir de initializer_list..." << std::endl;
     for (const auto& entrada : lista) {
         inserir(entrada); // Usa o método público de inserção
@@ -19,150 +136,224 @@ ABB::ABB(std::initializer_list<EntradaIndice> lista) : raiz(nullptr) {
     // Apenas para depuração: std::cout << "ABB criada a partir de initializer_list." << std::endl;
 }
 
-// Método auxiliar recursivo para o destrutor: Percorre a árvore em pós-ordem e deleta cada nó.
-void ABB::destruirRecursivo(NoABB* no) {
-    if (no) {
-        destruirRecursivo(no->esq); // Primeiro destrói a subárvore esquerda
-        destruirRecursivo(no->dir); // Depois destrói a subárvore direita
-        delete no;                   // Finalmente, deleta o próprio nó
-    }
-}
-
-// Destrutor: Chama o método auxiliar para desalocar toda a memória.
-ABB::~ABB() {
+// Destrutor: os nós pertencem à arena, que libera seus blocos ao ser destruída.
+// O custo é O(número de blocos), e não um 'delete' por nó.
+template <typename Chave>
+ABBGenerica<Chave>::~ABBGenerica() {
     // Apenas para depuração: std::cout << "Destrutor da ABB chamado. Liberando memória..." << std::endl;
-    destruirRecursivo(raiz); // Inicia a destruição a partir da raiz
-    raiz = nullptr;          // Garante que a raiz seja nula após a destruição
-    // Apenas para depuração: std::cout << "Memória da ABB liberada." << std::endl;
 }
 
-// Método auxiliar recursivo para o construtor de cópia e operador de atribuição:
-// Cria uma cópia profunda da subárvore original.
-NoABB* ABB::copiarRecursivo(const NoABB* noOriginal) {
-    if (noOriginal == nullptr) {
-        return nullptr; // Caso base: subárvore vazia
-    }
-    // Cria um novo nó, copia os dados e recursivamente copia as subárvores.
-    NoABB* novoNo = new NoABB(noOriginal->dado);
-    novoNo->esq = copiarRecursivo(noOriginal->esq);
-    novoNo->dir = copiarRecursivo(noOriginal->dir);
-    return novoNo;
+// Construtor de carga em lote: cria a árvore já balanceada a partir de um vetor de entradas.
+template <typename Chave>
+ABBGenerica<Chave>::ABBGenerica(std::vector<Entrada> entradas, bool jaOrdenadas, TipoBalanceamento tipo)
+    : raiz(INDICE_NULO), balanceamento(tipo), quantidade(0) {
+    carregarEmLote(std::move(entradas), jaOrdenadas);
 }
 
 // Construtor de cópia: Constrói uma nova ABB como uma cópia profunda de outra ABB.
-ABB::ABB(const ABB& outraABB) : raiz(nullptr) {
+// Como os filhos são índices na arena, basta copiar os blocos de nós: a estrutura
+// da árvore é preservada sem percorrê-la.
+template <typename Chave>
+ABBGenerica<Chave>::ABBGenerica(const ABBGenerica& outraABB)
+    : arena(outraABB.arena), raiz(outraABB.raiz),
+      balanceamento(outraABB.balanceamento), quantidade(outraABB.quantidade) {
     // Apenas para depuração: std::cout << "Construtor de cópia da ABB chamado." << std::endl;
-    raiz = copiarRecursivo(outraABB.raiz); // Inicia a cópia profunda
 }
 
 // Operador de atribuição de cópia: Permite que uma ABB existente seja atribuída a outra.
 // Garante auto-atribuição e segurança na liberação/cópia.
-ABB& ABB::operator=(const ABB& outraABB) {
+template <typename Chave>
+ABBGenerica<Chave>& ABBGenerica<Chave>::operator=(const ABBGenerica& outraABB) {
     // Apenas para depuração: std::cout << "Operador de atribuição de cópia da ABB chamado." << std::endl;
     if (this != &outraABB) { // Verifica auto-atribuição
-        // 1. Libera os recursos existentes no objeto atual
-        destruirRecursivo(raiz);
-        raiz = nullptr;
-
-        // 2. Copia os recursos da outra ABB
-        raiz = copiarRecursivo(outraABB.raiz);
+        // A arena libera os próprios blocos e copia os da outra ABB.
+        arena = outraABB.arena;
+        raiz = outraABB.raiz;
+        balanceamento = outraABB.balanceamento;
+        quantidade = outraABB.quantidade;
     }
     return *this; // Retorna uma referência para o próprio objeto
 }
 
 // 3. Inserção de um Registro (EntradaIndice) na ABB
 
-// Método público para iniciar o processo de inserção.
-void ABB::inserir(const EntradaIndice& novaEntrada) {
-    raiz = inserirRecursivo(raiz, novaEntrada);
+// Desce da raiz registrando o caminho até encontrar a posição vazia onde a nova
+// entrada deve ficar; depois cria o nó e sobe pelo caminho rebalanceando.
+template <typename Chave>
+void ABBGenerica<Chave>::inserir(const Entrada& novaEntrada) {
+    std::vector<Passo> caminho;
+    caminho.reserve(alturaDe(raiz) + 1);
+
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        // Compara a nova entrada com o dado do nó atual para decidir se vai para a esquerda ou direita.
+        // Usa o operador < sobrecarregado na EntradaIndice.
+        if (novaEntrada < arena[noAtual].dado) {
+            caminho.push_back(Passo{noAtual, true});
+            noAtual = arena[noAtual].esq;
+        } else if (novaEntrada > arena[noAtual].dado) {
+            caminho.push_back(Passo{noAtual, false});
+            noAtual = arena[noAtual].dir;
+        } else {
+            // Caso de chave duplicada: A ABB não permite chaves iguais para EntradaIndice.
+            std::cout << "ERRO: Entrada de indice com chave " << novaEntrada.getChave() << " já existe na ABB." << std::endl;
+            return;
+        }
+    }
+
+    // Encontramos o local para inserir: o novo nó vira filho do último nó do caminho (ou a raiz).
+    // Apenas para depuração: std::cout << "Inserindo chave no indice: " << novaEntrada.getChave() << std::endl;
+    Indice novoNo = arena.alocar(No(novaEntrada)); // Reaproveita um nó livre ou usa a próxima posição do bloco
+    ++quantidade;
+    religarCaminho(caminho, novoNo);
 }
 
-// Método auxiliar recursivo para inserção: Lógica principal da inserção na ABB.
-NoABB* ABB::inserirRecursivo(NoABB* noAtual, const EntradaIndice& novaEntrada) {
-    // Caso base: Se o nó atual é nulo, encontramos o local para inserir.
-    // Cria um novo nó e o retorna, tornando-o a nova raiz da subárvore (ou um novo filho).
-    if (noAtual == nullptr) {
-        // Apenas para depuração: std::cout << "Inserindo chave no indice: " << novaEntrada.getChave() << std::endl;
-        return new NoABB(novaEntrada);
+// 4. Remoção de um Registro (EntradaIndice) identificado por uma chave
+
+// Localiza o nó registrando o caminho. Se ele tiver dois filhos, recebe o dado do
+// sucessor in-order, e é o sucessor (que tem no máximo um filho) que sai da árvore.
+template <typename Chave>
+void ABBGenerica<Chave>::remover(const Chave& chaveRemover) {
+    // Apenas para depuração: std::cout << "Tentando remover chave de indice: " << chaveRemover << std::endl;
+    std::vector<Passo> caminho;
+    caminho.reserve(alturaDe(raiz) + 1);
+
+    // Compara a chave a ser removida com a chave do nó atual para navegar na árvore.
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO && chaveRemover != arena[noAtual].dado.getChave()) {
+        bool esquerda = chaveRemover < arena[noAtual].dado.getChave();
+        caminho.push_back(Passo{noAtual, esquerda});
+        noAtual = esquerda ? arena[noAtual].esq : arena[noAtual].dir;
+    }
+
+    // Se chegamos a um nó nulo, a chave não foi encontrada na árvore.
+    if (noAtual == INDICE_NULO) {
+        std::cout << "ERRO: Chave de indice " << chaveRemover << " não encontrada na ABB para remoção." << std::endl;
+        return;
     }
 
-    // Compara a nova entrada com o dado do nó atual para decidir se vai para a esquerda ou direita.
-    // Usa o operador < sobrecarregado na EntradaIndice.
-    if (novaEntrada < noAtual->dado) {
-        noAtual->esq = inserirRecursivo(noAtual->esq, novaEntrada);
-    } else if (novaEntrada > noAtual->dado) {
-        noAtual->dir = inserirRecursivo(noAtual->dir, novaEntrada);
-    } else {
-        // Caso de chave duplicada: A ABB não permite chaves iguais para EntradaIndice.
-        std::cout << "ERRO: Entrada de indice com chave " << novaEntrada.getChave() << " já existe na ABB." << std::endl;
+    // Caso 3: Nó a ser removido tem DOIS filhos.
+    // Encontra o sucessor in-order: o menor nó na subárvore direita do nó atual
+    // (que sempre terá 0 ou 1 filho). O nó atual logicamente "assume" os dados do sucessor,
+    // e o problema passa a ser remover o sucessor, que cai no Caso 1 ou 2.
+    if (arena[noAtual].esq != INDICE_NULO && arena[noAtual].dir != INDICE_NULO) {
+        caminho.push_back(Passo{noAtual, false});
+        Indice sucessor = arena[noAtual].dir;
+        while (arena[sucessor].esq != INDICE_NULO) {
+            caminho.push_back(Passo{sucessor, true});
+            sucessor = arena[sucessor].esq;
+        }
+        arena[noAtual].dado = arena[sucessor].dado;
+        noAtual = sucessor;
     }
 
-    // Retorna o nó atual (que pode ter sido a nova raiz da subárvore após uma inserção,
-    // ou o nó original se a inserção ocorreu em uma de suas subárvores).
-    return noAtual;
+    // Casos 1 e 2: o único filho (ou INDICE_NULO, se for folha) substitui o nó removido.
+    Indice substituto = arena[noAtual].esq != INDICE_NULO ? arena[noAtual].esq : arena[noAtual].dir;
+    arena.liberar(noAtual); // Devolve o nó à lista livre da arena
+    --quantidade;
+    religarCaminho(caminho, substituto);
+    // Apenas para depuração: std::cout << "Chave de indice " << chaveRemover << " removida." << std::endl;
 }
 
-// 4. Remoção de um Registro (EntradaIndice) identificado por uma chave
+// Sobe pelo caminho registrado na descida, do nó mais profundo até a raiz.
+template <typename Chave>
+void ABBGenerica<Chave>::religarCaminho(const std::vector<Passo>& caminho, Indice subarvore) {
+    for (size_t i = caminho.size(); i-- > 0;) {
+        Indice pai = caminho[i].no;
+        if (caminho[i].esquerda) {
+            arena[pai].esq = subarvore;
+        } else {
+            arena[pai].dir = subarvore;
+        }
 
-// Método público para iniciar o processo de remoção.
-void ABB::remover(const std::string& chaveRemover) {
-    // Apenas para depuração: std::cout << "Tentando remover chave de indice: " << chaveRemover << std::endl;
-    raiz = removerRecursivo(raiz, chaveRemover);
+        int alturaAnterior = arena[pai].altura;
+        subarvore = rebalancear(pai); // Nova raiz da subárvore, que pode ter mudado por uma rotação
+        if (subarvore == pai && arena[pai].altura == alturaAnterior) {
+            // Os ancestrais continuam apontando para 'pai' e suas alturas não mudam:
+            // sem rotações daqui para cima, só o tamanho muda (um nó a mais ou a menos).
+            while (i-- > 0) {
+                Indice ancestral = caminho[i].no;
+                arena[ancestral].tamanho = 1 + tamanhoDe(arena[ancestral].esq) + tamanhoDe(arena[ancestral].dir);
+            }
+            return;
+        }
+    }
+    raiz = subarvore;
 }
 
-// Método auxiliar recursivo para remoção: Lógica principal da remoção na ABB.
-NoABB* ABB::removerRecursivo(NoABB* noAtual, const std::string& chaveRemover) {
-    // Caso base 1: Se o nó atual é nulo, a chave não foi encontrada na árvore.
-    if (noAtual == nullptr) {
-        std::cout << "ERRO: Chave de indice " << chaveRemover << " não encontrada na ABB para remoção." << std::endl;
-        return nullptr;
+// Balanceamento AVL
+
+// Altura de uma subárvore: 0 para subárvore vazia.
+template <typename Chave>
+int ABBGenerica<Chave>::alturaDe(Indice no) const {
+    return no != INDICE_NULO ? arena[no].altura : 0;
+}
+
+// Tamanho de uma subárvore: 0 para subárvore vazia.
+template <typename Chave>
+uint32_t ABBGenerica<Chave>::tamanhoDe(Indice no) const {
+    return no != INDICE_NULO ? arena[no].tamanho : 0;
+}
+
+// Recalcula a altura e o tamanho de um nó a partir dos valores (já corretos) de seus filhos.
+template <typename Chave>
+void ABBGenerica<Chave>::atualizarAltura(Indice no) {
+    arena[no].altura = 1 + std::max(alturaDe(arena[no].esq), alturaDe(arena[no].dir));
+    arena[no].tamanho = 1 + tamanhoDe(arena[no].esq) + tamanhoDe(arena[no].dir);
+}
+
+// Fator de balanceamento: positivo quando a subárvore esquerda é mais alta.
+template <typename Chave>
+int ABBGenerica<Chave>::fatorBalanceamento(Indice no) const {
+    return alturaDe(arena[no].esq) - alturaDe(arena[no].dir);
+}
+
+// Rotação simples à direita: o filho esquerdo sobe e se torna a nova raiz da subárvore,
+// e a subárvore direita desse filho passa a ser a subárvore esquerda do antigo pai.
+template <typename Chave>
+typename ABBGenerica<Chave>::Indice ABBGenerica<Chave>::rotacionarDireita(Indice no) {
+    Indice novaRaiz = arena[no].esq;
+    arena[no].esq = arena[novaRaiz].dir;
+    arena[novaRaiz].dir = no;
+    atualizarAltura(no);       // 'no' agora está abaixo da nova raiz: atualiza primeiro
+    atualizarAltura(novaRaiz);
+    return novaRaiz;
+}
+
+// Rotação simples à esquerda: simétrica à rotação à direita.
+template <typename Chave>
+typename ABBGenerica<Chave>::Indice ABBGenerica<Chave>::rotacionarEsquerda(Indice no) {
+    Indice novaRaiz = arena[no].dir;
+    arena[no].dir = arena[novaRaiz].esq;
+    arena[novaRaiz].esq = no;
+    atualizarAltura(no);
+    atualizarAltura(novaRaiz);
+    return novaRaiz;
+}
+
+// Atualiza a altura do nó e, se a árvore for AVL e o nó estiver desbalanceado
+// (|fator| > 1), aplica a rotação simples ou dupla adequada.
+template <typename Chave>
+typename ABBGenerica<Chave>::Indice ABBGenerica<Chave>::rebalancear(Indice no) {
+    atualizarAltura(no);
+    if (balanceamento != TipoBalanceamento::AVL) {
+        return no;
     }
 
-    // Compara a chave a ser removida com a chave do nó atual para navegar na árvore.
-    if (chaveRemover < noAtual->dado.getChave()) {
-        noAtual->esq = removerRecursivo(noAtual->esq, chaveRemover); // Continua buscando na subárvore esquerda
-    } else if (chaveRemover > noAtual->dado.getChave()) {
-        noAtual->dir = removerRecursivo(noAtual->dir, chaveRemover); // Continua buscando na subárvore direita
-    } else { // A chave a ser removida foi encontrada no noAtual
-        
-        // Caso 1: Nó a ser removido não tem filho esquerdo (ou é uma folha)
-        if (noAtual->esq == nullptr) {
-            NoABB* temp = noAtual->dir; // O filho direito (ou nullptr) substitui o nó atual
-            delete noAtual;             // Deleta o nó atual
-            // Apenas para depuração: std::cout << "Chave de indice " << chaveRemover << " removida (caso 0 ou 1 filho)." << std::endl;
-            return temp;                // Retorna o substituto
-        } 
-        // Caso 2: Nó a ser removido não tem filho direito
-        else if (noAtual->dir == nullptr) {
-            NoABB* temp = noAtual->esq; // O filho esquerdo substitui o nó atual
-            delete noAtual;             // Deleta o nó atual
-            // Apenas para depuração: std::cout << "Chave de indice " << chaveRemover << " removida (caso 1 filho)." << std::endl;
-            return temp;                // Retorna o substituto
+    int fator = fatorBalanceamento(no);
+    if (fator > 1) {
+        // Subárvore esquerda mais alta. Caso esquerda-direita: rotação dupla.
+        if (fatorBalanceamento(arena[no].esq) < 0) {
+            arena[no].esq = rotacionarEsquerda(arena[no].esq);
         }
-        
-        // Caso 3: Nó a ser removido tem DOIS filhos
-        // Encontra o sucessor in-order: o menor nó na subárvore direita do nó atual.
-        // O sucessor in-order sempre terá 0 ou 1 filho.
-        NoABB* temp = encontrarMin(noAtual->dir); 
-        
-        // Copia o dado (chave e posição) do sucessor para o nó atual.
-        // O nó atual logicamente "assume" os dados do sucessor.
-        noAtual->dado = temp->dado;
-        
-        // Remove recursivamente o sucessor da subárvore direita.
-        // Agora, o problema de remover 'temp' cairá no Caso 1 ou 2.
-        noAtual->dir = removerRecursivo(noAtual->dir, temp->dado.getChave());
-        // Apenas para depuração: std::cout << "Chave de indice " << chaveRemover << " removida (substituída por sucessor)." << std::endl;
-    }
-    return noAtual; // Retorna o nó atual (que foi atualizado ou mantido)
-}
-
-// Método auxiliar para encontrar o nó com a menor chave em uma subárvore.
-// É usado na remoção para encontrar o sucessor in-order.
-NoABB* ABB::encontrarMin(NoABB* no) {
-    // O nó com a menor chave em uma ABB está sempre no final do caminho mais à esquerda.
-    while (no->esq != nullptr) {
-        no = no->esq;
+        return rotacionarDireita(no);
+    }
+    if (fator < -1) {
+        // Subárvore direita mais alta. Caso direita-esquerda: rotação dupla.
+        if (fatorBalanceamento(arena[no].dir) > 0) {
+            arena[no].dir = rotacionarDireita(arena[no].dir);
+        }
+        return rotacionarEsquerda(no);
     }
     return no;
 }
@@ -170,106 +361,481 @@ NoABB* ABB::encontrarMin(NoABB* no) {
 // 5. Deleção completa de uma ABB
 
 // Libera toda a memória alocada pelos nós da ABB, tornando-a vazia.
-void ABB::deletarABB() {
+template <typename Chave>
+void ABBGenerica<Chave>::deletarABB() {
     std::cout << "Deletando toda a ABB de indices..." << std::endl;
-    destruirRecursivo(raiz); // Reutiliza o método auxiliar de destruição
-    raiz = nullptr;          // Garante que a raiz seja nula após a deleção
+    arena.limpar();      // Libera os blocos de nós de uma só vez
+    raiz = INDICE_NULO;  // Garante que a raiz seja nula após a deleção
+    quantidade = 0;
     std::cout << "ABB de indices deletada." << std::endl;
 }
 
-// Percursos na ABB
+// 6. Carga em lote
 
-// Percurso em Pré-Ordem: (Raiz, Esquerda, Direita)
-void ABB::preOrdem() const {
-    std::cout << "\nPercurso em Pré-Ordem (Chave, Pos): ";
-    preOrdemRecursivo(raiz);
-    std::cout << std::endl;
-}
+// Substitui o conteúdo da árvore por uma árvore perfeitamente balanceada.
+// Com a entrada ordenada, cada elemento é visitado uma única vez: O(n), contra
+// O(n log n) de n inserções (ou O(n²) em uma ABB simples com chaves ordenadas).
+template <typename Chave>
+void ABBGenerica<Chave>::carregarEmLote(std::vector<Entrada> entradas, bool jaOrdenadas) {
+    if (!jaOrdenadas) {
+        ordenarParalelo(entradas);
+    }
 
-void ABB::preOrdemRecursivo(NoABB* no) const {
-    if (no) {
-        no->dado.imprimir();      // Visita a raiz (imprime o dado da EntradaIndice)
-        preOrdemRecursivo(no->esq); // Percorre a subárvore esquerda
-        preOrdemRecursivo(no->dir); // Percorre a subárvore direita
+    // Remove chaves repetidas (adjacentes após a ordenação), mantendo a primeira.
+    size_t unicas = 0;
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        if (unicas > 0 && entradas[i] == entradas[unicas - 1]) {
+            std::cout << "ERRO: Entrada de indice com chave " << entradas[i].getChave() << " já existe na ABB." << std::endl;
+            continue;
+        }
+        if (unicas != i) {
+            entradas[unicas] = entradas[i];
+        }
+        ++unicas;
     }
+    entradas.resize(unicas);
+
+    arena.limpar();
+    raiz = construirBalanceadaRecursivo(entradas, 0, entradas.size());
+    quantidade = entradas.size();
 }
 
-// Percurso em Ordem (Simétrica): (Esquerda, Raiz, Direita)
-// Imprime os elementos em ordem crescente de suas chaves.
-void ABB::emOrdem() const {
-    std::cout << "\nPercurso em Ordem (Chave, Pos) - Ordenado por Chave: ";
-    emOrdemRecursivo(raiz);
-    std::cout << std::endl;
+// O elemento do meio vira a raiz e as metades formam as subárvores.
+// A recursão tem profundidade O(log n), e os nós são alocados em pré-ordem,
+// o que deixa cada nó próximo do seu pai na arena.
+template <typename Chave>
+typename ABBGenerica<Chave>::Indice ABBGenerica<Chave>::construirBalanceadaRecursivo(
+    const std::vector<Entrada>& entradas, size_t inicio, size_t fim) {
+    if (inicio >= fim) {
+        return INDICE_NULO;
+    }
+    size_t meio = inicio + (fim - inicio) / 2;
+    Indice no = arena.alocar(No(entradas[meio]));
+    Indice esq = construirBalanceadaRecursivo(entradas, inicio, meio);
+    Indice dir = construirBalanceadaRecursivo(entradas, meio + 1, fim);
+    arena[no].esq = esq;
+    arena[no].dir = dir;
+    atualizarAltura(no);
+    return no;
 }
 
-void ABB::emOrdemRecursivo(NoABB* no) const {
-    if (no) {
-        emOrdemRecursivo(no->esq);  // Percorre a subárvore esquerda
-        no->dado.imprimir();       // Visita a raiz (imprime o dado da EntradaIndice)
-        emOrdemRecursivo(no->dir);  // Percorre a subárvore direita
+// Percursos na ABB
+
+// Percurso em Pré-Ordem: (Raiz, Esquerda, Direita)
+// A pilha guarda as subárvores a visitar; a direita é empilhada antes da esquerda
+// para que a esquerda saia primeiro.
+template <typename Chave>
+void ABBGenerica<Chave>::visitarPreOrdem(const Visitante& visitar) const {
+    std::vector<Indice> pilha;
+    if (raiz != INDICE_NULO) {
+        pilha.push_back(raiz);
+    }
+    while (!pilha.empty()) {
+        Indice no = pilha.back();
+        pilha.pop_back();
+        visitar(arena[no].dado); // Visita a raiz
+        if (arena[no].dir != INDICE_NULO) {
+            pilha.push_back(arena[no].dir);
+        }
+        if (arena[no].esq != INDICE_NULO) {
+            pilha.push_back(arena[no].esq);
+        }
     }
 }
 
-// Percurso em Pós-Ordem: (Esquerda, Direita, Raiz)
-// Útil para liberar a memória de forma segura (filhos antes dos pais).
-void ABB::posOrdem() const {
-    std::cout << "\nPercurso em Pós-Ordem (Chave, Pos): ";
-    posOrdemRecursivo(raiz);
-    std::cout << std::endl;
+// Percurso em Ordem (Simétrica): (Esquerda, Raiz, Direita)
+// Visita os elementos em ordem crescente de suas chaves, usando o próprio iterador.
+template <typename Chave>
+void ABBGenerica<Chave>::visitarEmOrdem(const Visitante& visitar) const {
+    for (IteradorEmOrdem it = begin(); it != end(); ++it) {
+        visitar(*it);
+    }
 }
 
-void ABB::posOrdemRecursivo(NoABB* no) const {
-    if (no) {
-        posOrdemRecursivo(no->esq);  // Percorre a subárvore esquerda
-        posOrdemRecursivo(no->dir);  // Percorre a subárvore direita
-        no->dado.imprimir();       // Visita a raiz (imprime o dado da EntradaIndice)
+// Percurso em Pós-Ordem: (Esquerda, Direita, Raiz)
+// A pilha guarda o caminho até o nó atual; um nó só é visitado quando sua subárvore
+// direita está vazia ou acabou de ser visitada ('ultimoVisitado').
+template <typename Chave>
+void ABBGenerica<Chave>::visitarPosOrdem(const Visitante& visitar) const {
+    std::vector<Indice> pilha;
+    Indice ultimoVisitado = INDICE_NULO;
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO || !pilha.empty()) {
+        if (noAtual != INDICE_NULO) {
+            pilha.push_back(noAtual);    // Desce pela esquerda
+            noAtual = arena[noAtual].esq;
+            continue;
+        }
+        Indice topo = pilha.back();
+        Indice dir = arena[topo].dir;
+        if (dir != INDICE_NULO && dir != ultimoVisitado) {
+            noAtual = dir;               // Ainda falta percorrer a subárvore direita
+        } else {
+            visitar(arena[topo].dado);   // Filhos já visitados: visita a raiz
+            ultimoVisitado = topo;
+            pilha.pop_back();
+        }
     }
 }
 
 // Percurso em Largura: Visita os nós nível por nível.
-void ABB::emLargura() const {
-    std::cout << "\nPercurso em Largura (Chave, Pos): " << std::endl;
-    if (raiz == nullptr) {
-        std::cout << "Árvore de índices vazia." << std::endl;
+template <typename Chave>
+void ABBGenerica<Chave>::visitarEmLargura(const Visitante& visitar) const {
+    if (raiz == INDICE_NULO) {
         return;
     }
 
-    std::queue<NoABB*> fila; // Usa uma fila para gerenciar a ordem de visita
+    std::queue<Indice> fila; // Usa uma fila para gerenciar a ordem de visita
     fila.push(raiz);         // Começa com a raiz
 
     while (!fila.empty()) {
-        NoABB* noAtual = fila.front(); // Pega o nó da frente da fila
+        Indice noAtual = fila.front(); // Pega o nó da frente da fila
         fila.pop();                    // Remove-o da fila
 
-        noAtual->dado.imprimir();      // Visita o nó (imprime o dado da EntradaIndice)
-        // std::cout << std::endl; // Opcional: quebra de linha após cada nó para visualização vertical
+        visitar(arena[noAtual].dado);  // Visita o nó
 
         // Adiciona os filhos à fila para serem visitados em seguida
-        if (noAtual->esq != nullptr) {
-            fila.push(noAtual->esq);
+        if (arena[noAtual].esq != INDICE_NULO) {
+            fila.push(arena[noAtual].esq);
         }
-        if (noAtual->dir != nullptr) {
-            fila.push(noAtual->dir);
+        if (arena[noAtual].dir != INDICE_NULO) {
+            fila.push(arena[noAtual].dir);
         }
     }
+}
+
+// Versões que imprimem o percurso no console.
+
+template <typename Chave>
+void ABBGenerica<Chave>::preOrdem() const {
+    std::cout << "\nPercurso em Pré-Ordem (Chave, Pos): ";
+    visitarPreOrdem([](const Entrada& entrada) { entrada.imprimir(); });
     std::cout << std::endl;
 }
 
+// Imprime os elementos em ordem crescente de suas chaves.
+template <typename Chave>
+void ABBGenerica<Chave>::emOrdem() const {
+    std::cout << "\nPercurso em Ordem (Chave, Pos) - Ordenado por Chave: ";
+    visitarEmOrdem([](const Entrada& entrada) { entrada.imprimir(); });
+    std::cout << std::endl;
+}
+
+template <typename Chave>
+void ABBGenerica<Chave>::posOrdem() const {
+    std::cout << "\nPercurso em Pós-Ordem (Chave, Pos): ";
+    visitarPosOrdem([](const Entrada& entrada) { entrada.imprimir(); });
+    std::cout << std::endl;
+}
+
+template <typename Chave>
+void ABBGenerica<Chave>::emLargura() const {
+    std::cout << "\nPercurso em Largura (Chave, Pos): " << std::endl;
+    if (raiz == INDICE_NULO) {
+        std::cout << "Árvore de índices vazia." << std::endl;
+        return;
+    }
+    visitarEmLargura([](const Entrada& entrada) { entrada.imprimir(); });
+    std::cout << std::endl;
+}
+
+// Consultas por faixa
+
+// Desce da raiz empilhando apenas os nós com chave >= 'chave' (onde a descida vai para a
+// esquerda); os demais e suas subárvores esquerdas ficam inteiros antes do limite.
+// A pilha resultante é exatamente a de um iterador posicionado na primeira chave >= 'chave'.
+template <typename Chave>
+typename ABBGenerica<Chave>::IteradorEmOrdem ABBGenerica<Chave>::lowerBound(const Chave& chave) const {
+    IteradorEmOrdem it;
+    it.arena = &arena;
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        if (arena[noAtual].dado.getChave() < chave) {
+            noAtual = arena[noAtual].dir;
+        } else {
+            it.pilha.push_back(noAtual);
+            noAtual = arena[noAtual].esq;
+        }
+    }
+    return it;
+}
+
+// Ao descer para a direita, a subárvore esquerda e o próprio nó ficam para trás:
+// todos são menores que a chave e entram na contagem de uma vez.
+template <typename Chave>
+size_t ABBGenerica<Chave>::contarMenores(const Chave& chave) const {
+    size_t menores = 0;
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        if (arena[noAtual].dado.getChave() < chave) {
+            menores += tamanhoDe(arena[noAtual].esq) + 1;
+            noAtual = arena[noAtual].dir;
+        } else {
+            noAtual = arena[noAtual].esq;
+        }
+    }
+    return menores;
+}
+
+template <typename Chave>
+typename ABBGenerica<Chave>::Entrada ABBGenerica<Chave>::selecionar(size_t ordem) const {
+    if (ordem >= quantidade) {
+        throw std::out_of_range("ABB::selecionar: ordem fora dos limites.");
+    }
+    return *iteradorNaOrdem(ordem);
+}
+
+// Número de chaves <= fim menos o número de chaves < inicio.
+template <typename Chave>
+size_t ABBGenerica<Chave>::contarIntervalo(const Chave& inicio, const Chave& fim) const {
+    if (fim < inicio) {
+        return 0;
+    }
+    size_t ateFim = 0;
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        if (fim < arena[noAtual].dado.getChave()) {
+            noAtual = arena[noAtual].esq;
+        } else {
+            ateFim += tamanhoDe(arena[noAtual].esq) + 1;
+            noAtual = arena[noAtual].dir;
+        }
+    }
+    return ateFim - contarMenores(inicio);
+}
+
+// O iterador é posicionado direto na primeira entrada da página.
+template <typename Chave>
+std::vector<typename ABBGenerica<Chave>::Entrada> ABBGenerica<Chave>::pagina(size_t numeroPagina, size_t tamanhoPagina) const {
+    std::vector<Entrada> resultado;
+    if (tamanhoPagina == 0 || quantidade == 0 || numeroPagina > (quantidade - 1) / tamanhoPagina) {
+        return resultado; // Página além do fim da listagem
+    }
+    size_t inicio = numeroPagina * tamanhoPagina;
+    size_t fim = inicio + std::min(tamanhoPagina, quantidade - inicio);
+    resultado.reserve(fim - inicio);
+    IteradorEmOrdem it = iteradorNaOrdem(inicio);
+    for (size_t ordem = inicio; ordem < fim; ++ordem, ++it) {
+        resultado.push_back(*it);
+    }
+    return resultado;
+}
+
+// Como em lowerBound, empilha os nós em que a descida vai para a esquerda (que ainda
+// serão visitados); o tamanho da subárvore esquerda diz para que lado descer.
+template <typename Chave>
+typename ABBGenerica<Chave>::IteradorEmOrdem ABBGenerica<Chave>::iteradorNaOrdem(size_t ordem) const {
+    IteradorEmOrdem it;
+    it.arena = &arena;
+    if (ordem >= quantidade) {
+        return it;
+    }
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        size_t tamanhoEsquerda = tamanhoDe(arena[noAtual].esq);
+        if (ordem < tamanhoEsquerda) {
+            it.pilha.push_back(noAtual);
+            noAtual = arena[noAtual].esq;
+        } else if (ordem == tamanhoEsquerda) {
+            it.pilha.push_back(noAtual);
+            break;
+        } else {
+            ordem -= tamanhoEsquerda + 1;
+            noAtual = arena[noAtual].dir;
+        }
+    }
+    return it;
+}
+
+// Igual a lowerBound, mas empilhando apenas os nós com chave estritamente maior.
+template <typename Chave>
+typename ABBGenerica<Chave>::IteradorEmOrdem ABBGenerica<Chave>::upperBound(const Chave& chave) const {
+    IteradorEmOrdem it;
+    it.arena = &arena;
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        if (chave < arena[noAtual].dado.getChave()) {
+            it.pilha.push_back(noAtual);
+            noAtual = arena[noAtual].esq;
+        } else {
+            noAtual = arena[noAtual].dir;
+        }
+    }
+    return it;
+}
+
+template <typename Chave>
+void ABBGenerica<Chave>::visitarIntervalo(const Chave& inicio, const Chave& fim, const Visitante& visitar) const {
+    for (IteradorEmOrdem it = lowerBound(inicio); it != end() && !(fim < it->getChave()); ++it) {
+        visitar(*it);
+    }
+}
+
+template <typename Chave>
+std::vector<int> ABBGenerica<Chave>::buscarIntervalo(const Chave& inicio, const Chave& fim) const {
+    std::vector<int> posicoes;
+    for (IteradorEmOrdem it = lowerBound(inicio); it != end() && !(fim < it->getChave()); ++it) {
+        posicoes.push_back(it->getPosicaoEDL());
+    }
+    return posicoes;
+}
+
+template <typename Chave>
+std::vector<int> ABBGenerica<Chave>::buscarPrefixo(const std::string& prefixo) const {
+    FaixaPrefixo<Chave> faixa(prefixo);
+    std::vector<int> posicoes;
+    for (IteradorEmOrdem it = lowerBound(faixa.menor); it != end() && faixa.contem(it->getChave()); ++it) {
+        posicoes.push_back(it->getPosicaoEDL());
+    }
+    return posicoes;
+}
+
 // Método de busca para encontrar a posição de um registro na EDL dado seu CPF.
 // Retorna a posição (int) se encontrada, ou -1 se a chave não existir.
-int ABB::buscarPosicao(const std::string& chaveBusca) const {
-    NoABB* noAtual = raiz;
-    while (noAtual != nullptr) {
+template <typename Chave>
+int ABBGenerica<Chave>::buscarPosicao(const Chave& chaveBusca) const {
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
         // Compara a chave buscada com a chave do nó atual.
-        if (chaveBusca < noAtual->dado.getChave()) {
-            noAtual = noAtual->esq; // Se menor, vai para a esquerda
-        } else if (chaveBusca > noAtual->dado.getChave()) {
-            noAtual = noAtual->dir; // Se maior, vai para a direita
+        if (chaveBusca < arena[noAtual].dado.getChave()) {
+            noAtual = arena[noAtual].esq; // Se menor, vai para a esquerda
+        } else if (chaveBusca > arena[noAtual].dado.getChave()) {
+            noAtual = arena[noAtual].dir; // Se maior, vai para a direita
         } else {
             // Chave encontrada! Retorna a posição na EDL armazenada no nó.
-            return noAtual->dado.getPosicaoEDL();
+            return arena[noAtual].dado.getPosicaoEDL();
         }
     }
-    // Se o loop terminar e o nó atual for nullptr, a chave não foi encontrada.
+    // Se o loop terminar e o nó atual for INDICE_NULO, a chave não foi encontrada.
     return -1;
-}
\ No newline at end of file
+}
+
+// A chave não muda, então o nó continua no mesmo lugar: basta trocar a entrada.
+template <typename Chave>
+bool ABBGenerica<Chave>::atualizarPosicao(const Chave& chave, int posicaoAntiga, int posicaoNova) {
+    Indice noAtual = raiz;
+    while (noAtual != INDICE_NULO) {
+        if (chave < arena[noAtual].dado.getChave()) {
+            noAtual = arena[noAtual].esq;
+        } else if (arena[noAtual].dado.getChave() < chave) {
+            noAtual = arena[noAtual].dir;
+        } else {
+            if (arena[noAtual].dado.getPosicaoEDL() != posicaoAntiga) {
+                return false;
+            }
+            arena[noAtual].dado = Entrada(chave, posicaoNova);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Busca em lote com prefetch em grupo.
+// Cada rodada avança um nível em todas as buscas ainda ativas do grupo e dispara o
+// prefetch do próximo nó de cada uma; quando a rodada volta a uma busca, seu nó
+// provavelmente já chegou ao cache.
+template <typename Chave>
+void ABBGenerica<Chave>::buscarPosicoes(const Chave* chaves, size_t numeroChaves, int* posicoes) const {
+    Indice atual[BUSCAS_POR_GRUPO];
+    for (size_t inicio = 0; inicio < numeroChaves; inicio += BUSCAS_POR_GRUPO) {
+        size_t tamanhoGrupo = std::min(BUSCAS_POR_GRUPO, numeroChaves - inicio);
+        for (size_t i = 0; i < tamanhoGrupo; ++i) {
+            atual[i] = raiz;
+            posicoes[inicio + i] = -1; // Até ser encontrada, a chave é considerada ausente
+        }
+
+        size_t ativas = raiz != INDICE_NULO ? tamanhoGrupo : 0;
+        while (ativas > 0) {
+            for (size_t i = 0; i < tamanhoGrupo; ++i) {
+                Indice no = atual[i];
+                if (no == INDICE_NULO) {
+                    continue; // Busca já terminada
+                }
+                const No& noAtual = arena[no];
+                const Chave& chaveBusca = chaves[inicio + i];
+                if (chaveBusca < noAtual.dado.getChave()) {
+                    no = noAtual.esq;
+                } else if (noAtual.dado.getChave() < chaveBusca) {
+                    no = noAtual.dir;
+                } else {
+                    posicoes[inicio + i] = noAtual.dado.getPosicaoEDL();
+                    no = INDICE_NULO;
+                }
+                atual[i] = no;
+                if (no != INDICE_NULO) {
+                    PREFETCH_LEITURA(&arena[no]);
+                } else {
+                    --ativas;
+                }
+            }
+        }
+    }
+}
+
+template <typename Chave>
+std::vector<int> ABBGenerica<Chave>::buscarPosicoes(const std::vector<Chave>& chaves) const {
+    std::vector<int> posicoes(chaves.size());
+    if (!chaves.empty()) {
+        buscarPosicoes(chaves.data(), chaves.size(), posicoes.data());
+    }
+    return posicoes;
+}
+
+// Estatísticas
+
+// A altura de cada nó é mantida em inserções e remoções, então basta ler a da raiz.
+template <typename Chave>
+int ABBGenerica<Chave>::getAltura() const {
+    return alturaDe(raiz);
+}
+
+// Soma a profundidade de todos os nós com um percurso em largura (sem recursão)
+// e divide pelo número de nós.
+template <typename Chave>
+double ABBGenerica<Chave>::getProfundidadeMedia() const {
+    if (raiz == INDICE_NULO) {
+        return 0.0;
+    }
+
+    std::queue<std::pair<Indice, int>> fila; // Pares (nó, profundidade)
+    fila.push(std::make_pair(raiz, 0));
+    unsigned long long somaProfundidades = 0;
+    unsigned long long nos = 0;
+
+    while (!fila.empty()) {
+        Indice no = fila.front().first;
+        int profundidade = fila.front().second;
+        fila.pop();
+
+        somaProfundidades += profundidade;
+        ++nos;
+        if (arena[no].esq != INDICE_NULO) {
+            fila.push(std::make_pair(arena[no].esq, profundidade + 1));
+        }
+        if (arena[no].dir != INDICE_NULO) {
+            fila.push(std::make_pair(arena[no].dir, profundidade + 1));
+        }
+    }
+    return static_cast<double>(somaProfundidades) / nos;
+}
+
+template <typename Chave>
+size_t ABBGenerica<Chave>::getTamanho() const {
+    return quantidade;
+}
+
+template <typename Chave>
+TipoBalanceamento ABBGenerica<Chave>::getBalanceamento() const {
+    return balanceamento;
+}
+
+template <typename Chave>
+size_t ABBGenerica<Chave>::getMemoriaNos() const {
+    return arena.getBytesReservados();
+}
+
+// Instanciações explícitas: as definições do template ficam neste arquivo,
+// e apenas os tipos de chave usados pelo sistema são gerados.
+template class ABBGenerica<ChaveCPF>;
+template class ABBGenerica<std::string>;
+template class ABBGenerica<ChaveSecundaria>;
@@ -0,0 +1,457 @@
+#include "bmais/ArvoreBMais.h"
+#include <iostream>
+#include <algorithm> // Para std::lower_bound, std::upper_bound, std::copy e std::sort
+
+// Construtor padrão: árvore vazia.
+ArvoreBMais::ArvoreBMais() : raiz(nullptr), quantidade(0), altura(0) {}
+
+// Destrutor: libera todos os nós.
+ArvoreBMais::~ArvoreBMais() {
+    destruir();
+}
+
+// Libera os nós nível por nível usando uma pilha explícita, sem recursão.
+void ArvoreBMais::destruir() {
+    if (raiz == nullptr) {
+        return;
+    }
+    std::vector<NoBMais*> pilha;
+    pilha.push_back(raiz);
+    while (!pilha.empty()) {
+        NoBMais* no = pilha.back();
+        pilha.pop_back();
+        if (no->folha) {
+            delete static_cast<NoFolhaBMais*>(no);
+        } else {
+            NoInternoBMais* interno = static_cast<NoInternoBMais*>(no);
+            for (int i = 0; i <= interno->quantidade; ++i) {
+                pilha.push_back(interno->filhos[i]);
+            }
+            delete interno;
+        }
+    }
+    raiz = nullptr;
+    quantidade = 0;
+    altura = 0;
+}
+
+// Métodos auxiliares de navegação
+
+int ArvoreBMais::indiceFilho(const NoInternoBMais* no, const ChaveBMais& chave) {
+    // Separadores iguais à chave mandam a busca para a direita (filhos[i + 1] contém chaves >= chaves[i]).
+    return static_cast<int>(std::upper_bound(no->chaves, no->chaves + no->quantidade, chave) - no->chaves);
+}
+
+int ArvoreBMais::indiceNaFolha(const NoFolhaBMais* folha, const ChaveBMais& chave) {
+    return static_cast<int>(std::lower_bound(folha->chaves, folha->chaves + folha->quantidade, chave) - folha->chaves);
+}
+
+NoFolhaBMais* ArvoreBMais::descer(const ChaveBMais& chave, Caminho* caminho) const {
+    NoBMais* no = raiz;
+    while (!no->folha) {
+        NoInternoBMais* interno = static_cast<NoInternoBMais*>(no);
+        int i = indiceFilho(interno, chave);
+        if (caminho) {
+            caminho->push_back(std::make_pair(interno, i));
+        }
+        no = interno->filhos[i];
+    }
+    return static_cast<NoFolhaBMais*>(no);
+}
+
+// Inserção
+
+void ArvoreBMais::inserir(const EntradaIndice& novaEntrada) {
+    const ChaveBMais& chave = novaEntrada.getChave();
+    int posicao = novaEntrada.getPosicaoEDL();
+
+    // Árvore vazia: a raiz passa a ser uma folha com a única entrada.
+    if (raiz == nullptr) {
+        NoFolhaBMais* folha = new NoFolhaBMais();
+        folha->chaves[0] = chave;
+        folha->posicoes[0] = posicao;
+        folha->quantidade = 1;
+        raiz = folha;
+        altura = 1;
+        quantidade = 1;
+        return;
+    }
+
+    Caminho caminho;
+    NoFolhaBMais* folha = descer(chave, &caminho);
+    int i = indiceNaFolha(folha, chave);
+    if (i < folha->quantidade && folha->chaves[i] == chave) {
+        // Mesma política da ABB: a chave (CPF) é única no índice.
+        std::cout << "ERRO: Entrada de indice com chave " << chave << " já existe na Árvore B+." << std::endl;
+        return;
+    }
+    ++quantidade;
+
+    // Caso simples: há espaço na folha, basta deslocar as entradas maiores.
+    if (folha->quantidade < MAX_CHAVES_FOLHA) {
+        std::copy_backward(folha->chaves + i, folha->chaves + folha->quantidade, folha->chaves + folha->quantidade + 1);
+        std::copy_backward(folha->posicoes + i, folha->posicoes + folha->quantidade, folha->posicoes + folha->quantidade + 1);
+        folha->chaves[i] = chave;
+        folha->posicoes[i] = posicao;
+        ++folha->quantidade;
+        return;
+    }
+
+    // Folha cheia: monta a sequência com MAX + 1 entradas e divide ao meio.
+    ChaveBMais chavesTemp[MAX_CHAVES_FOLHA + 1];
+    int posicoesTemp[MAX_CHAVES_FOLHA + 1];
+    std::copy(folha->chaves, folha->chaves + i, chavesTemp);
+    std::copy(folha->posicoes, folha->posicoes + i, posicoesTemp);
+    chavesTemp[i] = chave;
+    posicoesTemp[i] = posicao;
+    std::copy(folha->chaves + i, folha->chaves + MAX_CHAVES_FOLHA, chavesTemp + i + 1);
+    std::copy(folha->posicoes + i, folha->posicoes + MAX_CHAVES_FOLHA, posicoesTemp + i + 1);
+
+    const int total = MAX_CHAVES_FOLHA + 1;
+    const int metade = total / 2;
+    NoFolhaBMais* novaFolha = new NoFolhaBMais();
+    std::copy(chavesTemp, chavesTemp + metade, folha->chaves);
+    std::copy(posicoesTemp, posicoesTemp + metade, folha->posicoes);
+    folha->quantidade = metade;
+    std::copy(chavesTemp + metade, chavesTemp + total, novaFolha->chaves);
+    std::copy(posicoesTemp + metade, posicoesTemp + total, novaFolha->posicoes);
+    novaFolha->quantidade = total - metade;
+
+    // Mantém o encadeamento das folhas.
+    novaFolha->proxima = folha->proxima;
+    folha->proxima = novaFolha;
+
+    // Em uma Árvore B+, a primeira chave da nova folha é copiada para o pai como separador.
+    inserirNoPai(caminho, novaFolha->chaves[0], novaFolha);
+}
+
+void ArvoreBMais::inserirNoPai(Caminho& caminho, ChaveBMais separador, NoBMais* novoFilho) {
+    while (!caminho.empty()) {
+        NoInternoBMais* pai = caminho.back().first;
+        int i = caminho.back().second; // O filho dividido estava em filhos[i]
+        caminho.pop_back();
+
+        if (pai->quantidade < MAX_CHAVES_INTERNO) {
+            std::copy_backward(pai->chaves + i, pai->chaves + pai->quantidade, pai->chaves + pai->quantidade + 1);
+            std::copy_backward(pai->filhos + i + 1, pai->filhos + pai->quantidade + 1, pai->filhos + pai->quantidade + 2);
+            pai->chaves[i] = separador;
+            pai->filhos[i + 1] = novoFilho;
+            ++pai->quantidade;
+            return;
+        }
+
+        // Nó interno cheio: monta MAX + 1 chaves e MAX + 2 filhos e divide.
+        ChaveBMais chavesTemp[MAX_CHAVES_INTERNO + 1];
+        NoBMais* filhosTemp[MAX_CHAVES_INTERNO + 2];
+        std::copy(pai->chaves, pai->chaves + i, chavesTemp);
+        chavesTemp[i] = separador;
+        std::copy(pai->chaves + i, pai->chaves + MAX_CHAVES_INTERNO, chavesTemp + i + 1);
+        std::copy(pai->filhos, pai->filhos + i + 1, filhosTemp);
+        filhosTemp[i + 1] = novoFilho;
+        std::copy(pai->filhos + i + 1, pai->filhos + MAX_CHAVES_INTERNO + 1, filhosTemp + i + 2);
+
+        // A chave do meio sobe para o avô; as demais são repartidas entre os dois nós.
+        const int total = MAX_CHAVES_INTERNO + 1;
+        const int meio = total / 2;
+        NoInternoBMais* novoInterno = new NoInternoBMais();
+        std::copy(chavesTemp, chavesTemp + meio, pai->chaves);
+        std::copy(filhosTemp, filhosTemp + meio + 1, pai->filhos);
+        pai->quantidade = meio;
+        std::copy(chavesTemp + meio + 1, chavesTemp + total, novoInterno->chaves);
+        std::copy(filhosTemp + meio + 1, filhosTemp + total + 1, novoInterno->filhos);
+        novoInterno->quantidade = total - meio - 1;
+
+        separador = chavesTemp[meio];
+        novoFilho = novoInterno;
+    }
+
+    // A divisão chegou à raiz: cria uma nova raiz com dois filhos.
+    NoInternoBMais* novaRaiz = new NoInternoBMais();
+    novaRaiz->chaves[0] = separador;
+    novaRaiz->filhos[0] = raiz;
+    novaRaiz->filhos[1] = novoFilho;
+    novaRaiz->quantidade = 1;
+    raiz = novaRaiz;
+    ++altura;
+}
+
+// Carga em lote
+
+// As folhas são preenchidas da esquerda para a direita, com as n entradas repartidas
+// igualmente entre ceil(n / MAX) folhas; cada nível interno é montado do mesmo modo sobre
+// o nível de baixo, com a menor chave de cada filho (exceto o primeiro) como separador.
+// Repartir igualmente garante a ocupação mínima em todos os nós, como depois de inserções.
+void ArvoreBMais::carregarEmLote(std::vector<EntradaIndice> entradas, bool jaOrdenadas) {
+    if (!jaOrdenadas) {
+        // Mesma chave: a entrada de menor posição vem primeiro e é a que permanece.
+        std::sort(entradas.begin(), entradas.end(), [](const EntradaIndice& a, const EntradaIndice& b) {
+            return a < b || (!(b < a) && a.getPosicaoEDL() < b.getPosicaoEDL());
+        });
+    }
+
+    // Remove chaves repetidas (adjacentes após a ordenação), mantendo a primeira.
+    size_t unicas = 0;
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        if (unicas > 0 && entradas[i] == entradas[unicas - 1]) {
+            std::cout << "ERRO: Entrada de indice com chave " << entradas[i].getChave() << " já existe na Árvore B+." << std::endl;
+            continue;
+        }
+        if (unicas != i) {
+            entradas[unicas] = entradas[i];
+        }
+        ++unicas;
+    }
+    entradas.resize(unicas);
+
+    destruir();
+    if (entradas.empty()) {
+        return;
+    }
+
+    // Folhas, já encadeadas, e a menor chave de cada uma.
+    const size_t n = entradas.size();
+    const size_t numFolhas = (n + MAX_CHAVES_FOLHA - 1) / MAX_CHAVES_FOLHA;
+    std::vector<NoBMais*> nivel;
+    std::vector<ChaveBMais> menores;
+    nivel.reserve(numFolhas);
+    menores.reserve(numFolhas);
+    NoFolhaBMais* anterior = nullptr;
+    for (size_t f = 0; f < numFolhas; ++f) {
+        size_t inicio = n * f / numFolhas;
+        size_t fim = n * (f + 1) / numFolhas;
+        NoFolhaBMais* folha = new NoFolhaBMais();
+        for (size_t i = inicio; i < fim; ++i) {
+            folha->chaves[i - inicio] = entradas[i].getChave();
+            folha->posicoes[i - inicio] = entradas[i].getPosicaoEDL();
+        }
+        folha->quantidade = static_cast<uint16_t>(fim - inicio);
+        if (anterior != nullptr) {
+            anterior->proxima = folha;
+        }
+        anterior = folha;
+        nivel.push_back(folha);
+        menores.push_back(folha->chaves[0]);
+    }
+    altura = 1;
+
+    // Níveis internos, até restar um único nó (a raiz).
+    while (nivel.size() > 1) {
+        const size_t m = nivel.size();
+        const size_t numNos = (m + MAX_CHAVES_INTERNO) / (MAX_CHAVES_INTERNO + 1);
+        std::vector<NoBMais*> acima;
+        std::vector<ChaveBMais> menoresAcima;
+        acima.reserve(numNos);
+        menoresAcima.reserve(numNos);
+        for (size_t k = 0; k < numNos; ++k) {
+            size_t inicio = m * k / numNos;
+            size_t fim = m * (k + 1) / numNos;
+            NoInternoBMais* no = new NoInternoBMais();
+            no->filhos[0] = nivel[inicio];
+            for (size_t j = inicio + 1; j < fim; ++j) {
+                no->chaves[j - inicio - 1] = menores[j];
+                no->filhos[j - inicio] = nivel[j];
+            }
+            no->quantidade = static_cast<uint16_t>(fim - inicio - 1);
+            acima.push_back(no);
+            menoresAcima.push_back(menores[inicio]);
+        }
+        nivel.swap(acima);
+        menores.swap(menoresAcima);
+        ++altura;
+    }
+    raiz = nivel[0];
+    quantidade = n;
+}
+
+// Remoção
+
+void ArvoreBMais::remover(const ChaveBMais& chave) {
+    if (raiz == nullptr) {
+        std::cout << "ERRO: Chave de indice " << chave << " não encontrada na Árvore B+ para remoção." << std::endl;
+        return;
+    }
+
+    Caminho caminho;
+    NoFolhaBMais* folha = descer(chave, &caminho);
+    int i = indiceNaFolha(folha, chave);
+    if (i >= folha->quantidade || folha->chaves[i] != chave) {
+        std::cout << "ERRO: Chave de indice " << chave << " não encontrada na Árvore B+ para remoção." << std::endl;
+        return;
+    }
+
+    std::copy(folha->chaves + i + 1, folha->chaves + folha->quantidade, folha->chaves + i);
+    std::copy(folha->posicoes + i + 1, folha->posicoes + folha->quantidade, folha->posicoes + i);
+    --folha->quantidade;
+    --quantidade;
+
+    // Sobe corrigindo nós que ficaram abaixo da ocupação mínima.
+    // Separadores antigos nos nós internos podem continuar apontando para chaves
+    // removidas: isso é válido em uma Árvore B+, pois eles só orientam a descida.
+    NoBMais* no = folha;
+    while (!caminho.empty()) {
+        size_t minimo = no->folha ? MIN_CHAVES_FOLHA : MIN_CHAVES_INTERNO;
+        if (no->quantidade >= minimo) {
+            break;
+        }
+        NoInternoBMais* pai = caminho.back().first;
+        int indice = caminho.back().second;
+        caminho.pop_back();
+        if (!corrigirOcupacao(no, pai, indice)) {
+            break; // Empréstimo resolveu; o pai não mudou de tamanho
+        }
+        no = pai;
+    }
+
+    // Ajusta a raiz: uma raiz interna sem chaves é substituída pelo único filho;
+    // uma raiz folha vazia significa árvore vazia.
+    if (raiz->folha) {
+        if (raiz->quantidade == 0) {
+            delete static_cast<NoFolhaBMais*>(raiz);
+            raiz = nullptr;
+            altura = 0;
+        }
+    } else if (raiz->quantidade == 0) {
+        NoInternoBMais* antigaRaiz = static_cast<NoInternoBMais*>(raiz);
+        raiz = antigaRaiz->filhos[0];
+        delete antigaRaiz;
+        --altura;
+    }
+}
+
+bool ArvoreBMais::corrigirOcupacao(NoBMais* no, NoInternoBMais* pai, int indice) {
+    NoBMais* irmaoEsq = indice > 0 ? pai->filhos[indice - 1] : nullptr;
+    NoBMais* irmaoDir = indice < pai->quantidade ? pai->filhos[indice + 1] : nullptr;
+
+    if (no->folha) {
+        NoFolhaBMais* folha = static_cast<NoFolhaBMais*>(no);
+        NoFolhaBMais* esq = static_cast<NoFolhaBMais*>(irmaoEsq);
+        NoFolhaBMais* dir = static_cast<NoFolhaBMais*>(irmaoDir);
+
+        // 1. Empresta a última entrada do irmão esquerdo.
+        if (esq && esq->quantidade > MIN_CHAVES_FOLHA) {
+            std::copy_backward(folha->chaves, folha->chaves + folha->quantidade, folha->chaves + folha->quantidade + 1);
+            std::copy_backward(folha->posicoes, folha->posicoes + folha->quantidade, folha->posicoes + folha->quantidade + 1);
+            folha->chaves[0] = esq->chaves[esq->quantidade - 1];
+            folha->posicoes[0] = esq->posicoes[esq->quantidade - 1];
+            ++folha->quantidade;
+            --esq->quantidade;
+            pai->chaves[indice - 1] = folha->chaves[0];
+            return false;
+        }
+        // 2. Empresta a primeira entrada do irmão direito.
+        if (dir && dir->quantidade > MIN_CHAVES_FOLHA) {
+            folha->chaves[folha->quantidade] = dir->chaves[0];
+            folha->posicoes[folha->quantidade] = dir->posicoes[0];
+            ++folha->quantidade;
+            std::copy(dir->chaves + 1, dir->chaves + dir->quantidade, dir->chaves);
+            std::copy(dir->posicoes + 1, dir->posicoes + dir->quantidade, dir->posicoes);
+            --dir->quantidade;
+            pai->chaves[indice] = dir->chaves[0];
+            return false;
+        }
+        // 3. Funde com um irmão: a folha da direita é absorvida pela da esquerda.
+        int separador = esq ? indice - 1 : indice;
+        NoFolhaBMais* destino = esq ? esq : folha;
+        NoFolhaBMais* origem = esq ? folha : dir;
+        std::copy(origem->chaves, origem->chaves + origem->quantidade, destino->chaves + destino->quantidade);
+        std::copy(origem->posicoes, origem->posicoes + origem->quantidade, destino->posicoes + destino->quantidade);
+        destino->quantidade += origem->quantidade;
+        destino->proxima = origem->proxima;
+        delete origem;
+
+        std::copy(pai->chaves + separador + 1, pai->chaves + pai->quantidade, pai->chaves + separador);
+        std::copy(pai->filhos + separador + 2, pai->filhos + pai->quantidade + 1, pai->filhos + separador + 1);
+        --pai->quantidade;
+        return true;
+    }
+
+    NoInternoBMais* interno = static_cast<NoInternoBMais*>(no);
+    NoInternoBMais* esq = static_cast<NoInternoBMais*>(irmaoEsq);
+    NoInternoBMais* dir = static_cast<NoInternoBMais*>(irmaoDir);
+
+    // 1. Rotação pela esquerda: o separador do pai desce e a última chave do irmão sobe.
+    if (esq && esq->quantidade > MIN_CHAVES_INTERNO) {
+        std::copy_backward(interno->chaves, interno->chaves + interno->quantidade, interno->chaves + interno->quantidade + 1);
+        std::copy_backward(interno->filhos, interno->filhos + interno->quantidade + 1, interno->filhos + interno->quantidade + 2);
+        interno->chaves[0] = pai->chaves[indice - 1];
+        interno->filhos[0] = esq->filhos[esq->quantidade];
+        ++interno->quantidade;
+        pai->chaves[indice - 1] = esq->chaves[esq->quantidade - 1];
+        --esq->quantidade;
+        return false;
+    }
+    // 2. Rotação pela direita: simétrica.
+    if (dir && dir->quantidade > MIN_CHAVES_INTERNO) {
+        interno->chaves[interno->quantidade] = pai->chaves[indice];
+        interno->filhos[interno->quantidade + 1] = dir->filhos[0];
+        ++interno->quantidade;
+        pai->chaves[indice] = dir->chaves[0];
+        std::copy(dir->chaves + 1, dir->chaves + dir->quantidade, dir->chaves);
+        std::copy(dir->filhos + 1, dir->filhos + dir->quantidade + 1, dir->filhos);
+        --dir->quantidade;
+        return false;
+    }
+    // 3. Fusão: o separador do pai desce entre as chaves dos dois nós.
+    int separador = esq ? indice - 1 : indice;
+    NoInternoBMais* destino = esq ? esq : interno;
+    NoInternoBMais* origem = esq ? interno : dir;
+    destino->chaves[destino->quantidade] = pai->chaves[separador];
+    std::copy(origem->chaves, origem->chaves + origem->quantidade, destino->chaves + destino->quantidade + 1);
+    std::copy(origem->filhos, origem->filhos + origem->quantidade + 1, destino->filhos + destino->quantidade + 1);
+    destino->quantidade += origem->quantidade + 1;
+    delete origem;
+
+    std::copy(pai->chaves + separador + 1, pai->chaves + pai->quantidade, pai->chaves + separador);
+    std::copy(pai->filhos + separador + 2, pai->filhos + pai->quantidade + 1, pai->filhos + separador + 1);
+    --pai->quantidade;
+    return true;
+}
+
+// Busca
+
+int ArvoreBMais::buscarPosicao(const ChaveBMais& chave) const {
+    if (raiz == nullptr) {
+        return -1;
+    }
+    const NoFolhaBMais* folha = descer(chave, nullptr);
+    int i = indiceNaFolha(folha, chave);
+    if (i < folha->quantidade && folha->chaves[i] == chave) {
+        return folha->posicoes[i];
+    }
+    return -1;
+}
+
+// Percurso em ordem: desce até a folha mais à esquerda e segue os ponteiros 'proxima'.
+void ArvoreBMais::emOrdem() const {
+    std::cout << "\nPercurso em Ordem na Árvore B+ (Chave, Pos) - Ordenado por Chave: ";
+    if (raiz != nullptr) {
+        const NoBMais* no = raiz;
+        while (!no->folha) {
+            no = static_cast<const NoInternoBMais*>(no)->filhos[0];
+        }
+        for (const NoFolhaBMais* folha = static_cast<const NoFolhaBMais*>(no); folha; folha = folha->proxima) {
+            for (int i = 0; i < folha->quantidade; ++i) {
+                EntradaIndice(folha->chaves[i], folha->posicoes[i]).imprimir();
+            }
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Deleção completa
+
+void ArvoreBMais::deletarArvore() {
+    std::cout << "Deletando toda a Árvore B+ de indices..." << std::endl;
+    destruir();
+    std::cout << "Árvore B+ de indices deletada." << std::endl;
+}
+
+// Estatísticas
+
+size_t ArvoreBMais::getTamanho() const {
+    return quantidade;
+}
+
+int ArvoreBMais::getAltura() const {
+    return altura;
+}
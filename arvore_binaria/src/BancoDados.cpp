@@ -0,0 +1,277 @@
+#include "BancoDados.h"
+#include "Indexacao.h"
+#include "persistencia/Serializacao.h"
+#include <algorithm> // Para std::min e std::max
+#include <cerrno>
+#include <cstdio>    // Para std::rename
+#include <fstream>
+#include <iterator>  // Para std::istreambuf_iterator
+#include <limits>    // Para std::numeric_limits
+#include <stdexcept> // Para std::runtime_error
+#include <utility>   // Para std::move
+#include <vector>
+#include <fcntl.h>    // Para open
+#include <sys/stat.h> // Para mkdir
+#include <unistd.h>   // Para fsync, close
+
+namespace {
+
+const char ASSINATURA_CHECKPOINT[8] = {'B', 'D', 'C', 'H', 'K', '0', '0', '1'};
+
+// Cria o diretório da base, se ainda não existir, e o devolve.
+std::string prepararDiretorio(const std::string& diretorio) {
+    if (::mkdir(diretorio.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("BancoDados: nao foi possivel criar o diretorio '" + diretorio + "'.");
+    }
+    return diretorio;
+}
+
+} // namespace
+
+BancoDados::BancoDados(const std::string& diretorio, size_t operacoesPorGrupo, double taxaFalsosPositivos)
+    : diretorio(prepararDiretorio(diretorio)),
+      caminhoCheckpoint(diretorio + "/base.chk"),
+      indice(TipoBalanceamento::AVL),
+      taxaFiltro(taxaFalsosPositivos),
+      numeroCheckpoint(0),
+      diario(diretorio + "/base.wal"),
+      operacoesPorGrupo(operacoesPorGrupo == 0 ? 1 : operacoesPorGrupo),
+      operacoesReaplicadas(0) {
+    if (!(taxaFalsosPositivos >= 0.0 && taxaFalsosPositivos < 1.0)) {
+        throw std::invalid_argument("BancoDados: a taxa de falsos positivos deve estar em [0, 1).");
+    }
+    carregarCheckpoint();
+    reconstruirFiltro();
+
+    // Reaplica o que foi feito depois do checkpoint. Operações com número menor ou igual
+    // ao do checkpoint só aparecem se a queda aconteceu entre gravar o checkpoint e
+    // esvaziar o diário; elas já estão no checkpoint e são ignoradas.
+    diario.percorrer([this](const OperacaoDiario& operacao) {
+        if (operacao.numero <= numeroCheckpoint) {
+            return;
+        }
+        if (operacao.tipo == TipoOperacao::INSERCAO) {
+            aplicarInsercao(operacao.registro, ChaveCPF(operacao.cpf));
+        } else {
+            aplicarRemocao(ChaveCPF(operacao.cpf));
+        }
+        ++operacoesReaplicadas;
+    });
+    diario.avancarNumeracao(numeroCheckpoint);
+}
+
+int BancoDados::localizarCPF(const ChaveCPF& cpf) const {
+    if (!filtroCPF.podeConter(cpf.getValor())) {
+        return -1; // Certamente ausente: nem desce a árvore
+    }
+    return indice.buscarPosicao(cpf);
+}
+
+void BancoDados::reconstruirFiltro() {
+    if (taxaFiltro <= 0.0) {
+        return;
+    }
+    const size_t CAPACIDADE_MINIMA = 1024;
+    filtroCPF = FiltroBloom(std::max(2 * indice.getTamanho(), CAPACIDADE_MINIMA), taxaFiltro);
+    for (const EntradaIndice& entrada : indice) {
+        filtroCPF.adicionar(entrada.getChave().getValor());
+    }
+}
+
+int BancoDados::aplicarInsercao(const Registro& registro, const ChaveCPF& cpf) {
+    if (localizarCPF(cpf) != -1) {
+        return -1;
+    }
+    int posicao = registros.inserirRegistro(registro);
+    indice.inserir(EntradaIndice(cpf, posicao));
+    indiceNome.inserir(registro, posicao);
+    indiceNascimento.inserir(registro, posicao);
+    if (filtroCPF.isAtivo()) {
+        if (filtroCPF.getElementos() >= filtroCPF.getCapacidade()) {
+            reconstruirFiltro(); // O(n) a cada duplicação: O(1) amortizado por inserção
+        } else {
+            filtroCPF.adicionar(cpf.getValor());
+        }
+    }
+    return posicao;
+}
+
+// Os índices secundários saem antes da EDL, enquanto nome e data ainda podem ser lidos.
+bool BancoDados::aplicarRemocao(const ChaveCPF& cpf) {
+    int posicao = localizarCPF(cpf);
+    if (posicao == -1) {
+        return false;
+    }
+    const Registro& registro = registros.buscarPorPosicao(posicao);
+    indiceNome.remover(registro, posicao);
+    indiceNascimento.remover(registro, posicao);
+    return removerPorCPF(indice, registros, cpf);
+}
+
+void BancoDados::fecharGrupo() {
+    if (diario.getPendentes() >= operacoesPorGrupo) {
+        diario.confirmar();
+    }
+}
+
+// O CPF é validado e a duplicata verificada antes de registrar no diário, para que
+// toda operação do diário seja aplicável ao ser reaplicada.
+int BancoDados::inserir(const Registro& registro) {
+    ChaveCPF cpf(registro.getCpf());
+    if (localizarCPF(cpf) != -1) {
+        return -1;
+    }
+    diario.registrarInsercao(registro);
+    int posicao = aplicarInsercao(registro, cpf);
+    fecharGrupo();
+    return posicao;
+}
+
+bool BancoDados::remover(const ChaveCPF& cpf) {
+    if (localizarCPF(cpf) == -1) {
+        return false;
+    }
+    diario.registrarRemocao(cpf.formatar());
+    aplicarRemocao(cpf);
+    fecharGrupo();
+    return true;
+}
+
+void BancoDados::confirmar() {
+    diario.confirmar();
+}
+
+int BancoDados::buscarPosicao(const ChaveCPF& cpf) const {
+    return localizarCPF(cpf);
+}
+
+std::vector<int> BancoDados::buscarPorNome(const std::string& nome) const {
+    return indiceNome.buscar(nome);
+}
+
+std::vector<int> BancoDados::buscarPorDataNascimento(const std::string& data) const {
+    return indiceNascimento.buscar(data);
+}
+
+std::vector<int> BancoDados::buscarPorNascimentoEntre(const std::string& inicio, const std::string& fim) const {
+    return indiceNascimento.buscarIntervalo(inicio, fim);
+}
+
+void BancoDados::compactarRegistros() {
+    registros.compactar(std::numeric_limits<size_t>::max(),
+                        [this](const Registro& registro, int posicaoAntiga, int posicaoNova) {
+        indice.atualizarPosicao(registro.getCpf(), posicaoAntiga, posicaoNova);
+        indiceNome.mover(registro, posicaoAntiga, posicaoNova);
+        indiceNascimento.mover(registro, posicaoAntiga, posicaoNova);
+    });
+}
+
+// Formato do checkpoint:
+//   [assinatura "BDCHK001"][número da última operação: 8 bytes]
+//   [quantidade de registros: 8 bytes][registros: flag de deleção, CPF, nome, data, sexo]
+//   [quantidade de entradas: 8 bytes][entradas em ordem de CPF: valor do CPF (8), posição (4)]
+//   [soma FNV-1a de tudo o que vem antes: 4 bytes]
+void BancoDados::checkpoint() {
+    diario.confirmar();
+    compactarRegistros();
+
+    std::string conteudo(ASSINATURA_CHECKPOINT, sizeof(ASSINATURA_CHECKPOINT));
+    acrescentarValor(conteudo, diario.getUltimoNumero());
+    acrescentarValor(conteudo, static_cast<uint64_t>(registros.getTamanho()));
+    for (size_t i = 0; i < registros.getTamanho(); ++i) {
+        const Registro& registro = registros.buscarPorPosicao(static_cast<int>(i));
+        acrescentarValor(conteudo, static_cast<uint8_t>(registro.isDeletado() ? 1 : 0));
+        acrescentarTexto(conteudo, registro.getCpf());
+        acrescentarTexto(conteudo, registro.getNome());
+        acrescentarTexto(conteudo, registro.getDataNascimento());
+        acrescentarValor(conteudo, registro.getSexo());
+    }
+    acrescentarValor(conteudo, static_cast<uint64_t>(indice.getTamanho()));
+    for (const EntradaIndice& entrada : indice) {
+        acrescentarValor(conteudo, entrada.getChave().getValor());
+        acrescentarValor(conteudo, static_cast<int32_t>(entrada.getPosicaoEDL()));
+    }
+    acrescentarValor(conteudo, somaVerificacao(conteudo.data(), conteudo.size()));
+
+    // Grava no temporário, sincroniza e só então troca pelo checkpoint atual.
+    std::string temporario = caminhoCheckpoint + ".tmp";
+    int descritor = ::open(temporario.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descritor < 0) {
+        throw std::runtime_error("BancoDados: nao foi possivel criar '" + temporario + "'.");
+    }
+    try {
+        gravarTudo(descritor, conteudo.data(), conteudo.size(), temporario);
+        if (::fsync(descritor) != 0) {
+            throw std::runtime_error("BancoDados: falha ao sincronizar '" + temporario + "'.");
+        }
+    } catch (...) {
+        ::close(descritor);
+        throw;
+    }
+    ::close(descritor);
+    if (std::rename(temporario.c_str(), caminhoCheckpoint.c_str()) != 0) {
+        throw std::runtime_error("BancoDados: nao foi possivel substituir '" + caminhoCheckpoint + "'.");
+    }
+    sincronizarDiretorio(diretorio);
+
+    numeroCheckpoint = diario.getUltimoNumero();
+    diario.reiniciar();
+    reconstruirFiltro(); // Descarta os CPFs removidos desde a última reconstrução
+}
+
+void BancoDados::carregarCheckpoint() {
+    std::ifstream arquivo(caminhoCheckpoint, std::ios::binary);
+    if (!arquivo) {
+        return; // Base nova: ainda não há checkpoint
+    }
+    std::string conteudo((std::istreambuf_iterator<char>(arquivo)), std::istreambuf_iterator<char>());
+
+    const std::string erro = "BancoDados: checkpoint '" + caminhoCheckpoint + "' corrompido.";
+    if (conteudo.size() < sizeof(ASSINATURA_CHECKPOINT) + sizeof(uint32_t) ||
+        conteudo.compare(0, sizeof(ASSINATURA_CHECKPOINT), ASSINATURA_CHECKPOINT, sizeof(ASSINATURA_CHECKPOINT)) != 0) {
+        throw std::runtime_error(erro);
+    }
+    size_t tamanhoDados = conteudo.size() - sizeof(uint32_t);
+    uint32_t soma = 0;
+    LeitorBinario(&conteudo[tamanhoDados], sizeof(uint32_t)).ler(soma);
+    if (somaVerificacao(conteudo.data(), tamanhoDados) != soma) {
+        throw std::runtime_error(erro);
+    }
+
+    LeitorBinario leitor(&conteudo[sizeof(ASSINATURA_CHECKPOINT)], tamanhoDados - sizeof(ASSINATURA_CHECKPOINT));
+    uint64_t quantidade = 0;
+    if (!leitor.ler(numeroCheckpoint) || !leitor.ler(quantidade)) {
+        throw std::runtime_error(erro);
+    }
+    for (uint64_t i = 0; i < quantidade; ++i) {
+        uint8_t deletado = 0;
+        std::string cpf, nome, dataNascimento;
+        char sexo = ' ';
+        if (!leitor.ler(deletado) || !leitor.lerTexto(cpf) || !leitor.lerTexto(nome) ||
+            !leitor.lerTexto(dataNascimento) || !leitor.ler(sexo)) {
+            throw std::runtime_error(erro);
+        }
+        registros.inserirRegistro(deletado ? Registro() : Registro(cpf, nome, dataNascimento, sexo));
+    }
+
+    // O índice vem pronto e em ordem: a carga em lote monta a árvore em O(n), sem reordenar.
+    if (!leitor.ler(quantidade)) {
+        throw std::runtime_error(erro);
+    }
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(std::min<size_t>(static_cast<size_t>(quantidade), leitor.restantes() / 12));
+    for (uint64_t i = 0; i < quantidade; ++i) {
+        uint64_t valor = 0;
+        int32_t posicao = 0;
+        if (!leitor.ler(valor) || !leitor.ler(posicao)) {
+            throw std::runtime_error(erro);
+        }
+        entradas.push_back(EntradaIndice(ChaveCPF::deValor(valor), posicao));
+    }
+    if (leitor.restantes() != 0) {
+        throw std::runtime_error(erro);
+    }
+    indice.carregarEmLote(std::move(entradas), true);
+    indiceNome.reconstruir(registros);
+    indiceNascimento.reconstruir(registros);
+}
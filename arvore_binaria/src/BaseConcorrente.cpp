@@ -0,0 +1,61 @@
+#include "BaseConcorrente.h"
+#include "Indexacao.h"
+
+BaseConcorrente::BaseConcorrente() {}
+
+// As alterações são aplicadas às duas cópias: a verificação de duplicata dá o mesmo
+// resultado nas duas, então 'posicao' recebe o mesmo valor em ambas as aplicações.
+int BaseConcorrente::inserir(const Registro& registro) {
+    ChaveCPF cpf(registro.getCpf());
+    int posicao = -1;
+    base.escrever([&](BaseDados& dados) {
+        if (dados.indice.buscarPosicao(cpf) != -1) {
+            posicao = -1;
+            return;
+        }
+        posicao = dados.registros.inserirRegistro(registro);
+        dados.indice.inserir(EntradaIndice(cpf, posicao));
+    });
+    return posicao;
+}
+
+bool BaseConcorrente::remover(const ChaveCPF& cpf) {
+    bool removeu = false;
+    base.escrever([&](BaseDados& dados) {
+        removeu = removerPorCPF(dados.indice, dados.registros, cpf);
+    });
+    return removeu;
+}
+
+// A compactação é determinística (depende só do estado da base), então pode ser
+// aplicada às duas cópias como qualquer outra escrita.
+bool BaseConcorrente::compactar(size_t maxPassos) {
+    bool restam = false;
+    base.escrever([&](BaseDados& dados) {
+        restam = compactarEDL(dados.registros, dados.indice, maxPassos);
+    });
+    return restam;
+}
+
+int BaseConcorrente::buscarPosicao(const ChaveCPF& cpf) const {
+    return base.ler([&](const BaseDados& dados) {
+        return dados.indice.buscarPosicao(cpf);
+    });
+}
+
+bool BaseConcorrente::buscarRegistro(const ChaveCPF& cpf, Registro& resultado) const {
+    return base.ler([&](const BaseDados& dados) -> bool {
+        int posicao = dados.indice.buscarPosicao(cpf);
+        if (posicao == -1) {
+            return false;
+        }
+        resultado = dados.registros.buscarPorPosicao(posicao);
+        return true;
+    });
+}
+
+size_t BaseConcorrente::getTamanho() const {
+    return base.ler([](const BaseDados& dados) {
+        return dados.indice.getTamanho();
+    });
+}
@@ -0,0 +1,210 @@
+#include "persistencia/DiarioEscrita.h"
+#include "persistencia/Serializacao.h"
+#include <iostream>
+#include <stdexcept> // Para std::runtime_error
+#include <fcntl.h>    // Para open
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para pread, ftruncate, fdatasync, close
+
+namespace {
+
+// Tamanho do cabeçalho de cada entrada: tamanho do corpo + soma de verificação.
+const size_t TAM_CABECALHO_ENTRADA = 2 * sizeof(uint32_t);
+
+// Decodifica o corpo de uma entrada. Retorna false se o corpo não for uma operação válida.
+bool decodificarCorpo(const char* corpo, size_t tamanho, OperacaoDiario& operacao) {
+    LeitorBinario leitor(corpo, tamanho);
+    uint8_t tipo = 0;
+    if (!leitor.ler(operacao.numero) || !leitor.ler(tipo)) {
+        return false;
+    }
+    if (tipo == static_cast<uint8_t>(TipoOperacao::INSERCAO)) {
+        std::string cpf, nome, dataNascimento;
+        char sexo = ' ';
+        if (!leitor.lerTexto(cpf) || !leitor.lerTexto(nome) || !leitor.lerTexto(dataNascimento) ||
+            !leitor.ler(sexo)) {
+            return false;
+        }
+        operacao.tipo = TipoOperacao::INSERCAO;
+        operacao.registro = Registro(cpf, nome, dataNascimento, sexo);
+        operacao.cpf = cpf;
+    } else if (tipo == static_cast<uint8_t>(TipoOperacao::REMOCAO)) {
+        if (!leitor.lerTexto(operacao.cpf)) {
+            return false;
+        }
+        operacao.tipo = TipoOperacao::REMOCAO;
+        operacao.registro = Registro();
+    } else {
+        return false;
+    }
+    return leitor.restantes() == 0;
+}
+
+} // namespace
+
+DiarioEscrita::DiarioEscrita(const std::string& caminho)
+    : caminho(caminho), descritor(-1), bytesValidos(0), pendentes(0), ultimoNumero(0), sincronizacoes(0), bytesDescartados(0) {
+    descritor = ::open(caminho.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (descritor < 0) {
+        throw std::runtime_error("DiarioEscrita: nao foi possivel abrir '" + caminho + "'.");
+    }
+
+    try {
+        struct stat info;
+        if (::fstat(descritor, &info) != 0) {
+            throw std::runtime_error("DiarioEscrita: nao foi possivel ler o tamanho de '" + caminho + "'.");
+        }
+        bytesValidos = lerEntradas(nullptr, ultimoNumero);
+        bytesDescartados = static_cast<size_t>(info.st_size) - bytesValidos;
+        if (bytesDescartados > 0) {
+            // O final incompleto é cortado para que as próximas entradas sejam
+            // acrescentadas logo após a última entrada válida.
+            if (::ftruncate(descritor, static_cast<off_t>(bytesValidos)) != 0 || ::fdatasync(descritor) != 0) {
+                throw std::runtime_error("DiarioEscrita: nao foi possivel descartar o final de '" + caminho + "'.");
+            }
+        }
+    } catch (...) {
+        ::close(descritor);
+        throw;
+    }
+}
+
+DiarioEscrita::~DiarioEscrita() {
+    try {
+        confirmar();
+    } catch (const std::exception& erro) {
+        std::cout << "ERRO: " << erro.what() << std::endl;
+    }
+    ::close(descritor);
+}
+
+void DiarioEscrita::acrescentarEntrada(const std::string& corpo) {
+    acrescentarValor(buffer, static_cast<uint32_t>(corpo.size()));
+    acrescentarValor(buffer, somaVerificacao(corpo.data(), corpo.size()));
+    buffer.append(corpo);
+    ++pendentes;
+}
+
+// O corpo é montado por inteiro antes de mexer no buffer: se um campo for grande
+// demais, nada é acrescentado e o número de sequência não é consumido.
+uint64_t DiarioEscrita::registrarInsercao(const Registro& registro) {
+    std::string corpo;
+    acrescentarValor(corpo, ultimoNumero + 1);
+    acrescentarValor(corpo, static_cast<uint8_t>(TipoOperacao::INSERCAO));
+    acrescentarTexto(corpo, registro.getCpf());
+    acrescentarTexto(corpo, registro.getNome());
+    acrescentarTexto(corpo, registro.getDataNascimento());
+    acrescentarValor(corpo, registro.getSexo());
+    acrescentarEntrada(corpo);
+    return ++ultimoNumero;
+}
+
+uint64_t DiarioEscrita::registrarRemocao(const std::string& cpf) {
+    std::string corpo;
+    acrescentarValor(corpo, ultimoNumero + 1);
+    acrescentarValor(corpo, static_cast<uint8_t>(TipoOperacao::REMOCAO));
+    acrescentarTexto(corpo, cpf);
+    acrescentarEntrada(corpo);
+    return ++ultimoNumero;
+}
+
+// Todas as entradas pendentes vão para o disco com uma gravação e uma sincronização.
+void DiarioEscrita::confirmar() {
+    if (pendentes == 0) {
+        return;
+    }
+    try {
+        gravarTudo(descritor, buffer.data(), buffer.size(), caminho);
+        if (::fdatasync(descritor) != 0) {
+            throw std::runtime_error("DiarioEscrita: falha ao sincronizar '" + caminho + "'.");
+        }
+    } catch (...) {
+        // Corta uma gravação parcial: senão ela esconderia as entradas acrescentadas depois.
+        if (::ftruncate(descritor, static_cast<off_t>(bytesValidos)) != 0) {
+            std::cout << "ERRO: nao foi possivel desfazer a gravacao parcial em '" << caminho << "'." << std::endl;
+        }
+        throw;
+    }
+    bytesValidos += buffer.size();
+    ++sincronizacoes;
+    buffer.clear();
+    pendentes = 0;
+}
+
+size_t DiarioEscrita::lerEntradas(const Visitante* visitar, uint64_t& ultimo) const {
+    struct stat info;
+    if (::fstat(descritor, &info) != 0) {
+        throw std::runtime_error("DiarioEscrita: nao foi possivel ler o tamanho de '" + caminho + "'.");
+    }
+    std::string conteudo(static_cast<size_t>(info.st_size), '\0');
+    size_t lidos = 0;
+    while (lidos < conteudo.size()) {
+        ssize_t n = ::pread(descritor, &conteudo[lidos], conteudo.size() - lidos, static_cast<off_t>(lidos));
+        if (n < 0) {
+            throw std::runtime_error("DiarioEscrita: falha ao ler '" + caminho + "'.");
+        }
+        if (n == 0) {
+            break;
+        }
+        lidos += static_cast<size_t>(n);
+    }
+
+    // Percorre as entradas até o fim do arquivo ou até a primeira entrada inválida.
+    size_t posicao = 0;
+    OperacaoDiario operacao;
+    while (lidos - posicao >= TAM_CABECALHO_ENTRADA) {
+        LeitorBinario cabecalho(&conteudo[posicao], TAM_CABECALHO_ENTRADA);
+        uint32_t tamanhoCorpo = 0, soma = 0;
+        cabecalho.ler(tamanhoCorpo);
+        cabecalho.ler(soma);
+        if (lidos - posicao - TAM_CABECALHO_ENTRADA < tamanhoCorpo) {
+            break; // Entrada truncada
+        }
+        const char* corpo = &conteudo[posicao + TAM_CABECALHO_ENTRADA];
+        if (somaVerificacao(corpo, tamanhoCorpo) != soma || !decodificarCorpo(corpo, tamanhoCorpo, operacao) ||
+            operacao.numero <= ultimo) {
+            break; // Entrada corrompida (ou fora de ordem)
+        }
+        ultimo = operacao.numero;
+        if (visitar != nullptr) {
+            (*visitar)(operacao);
+        }
+        posicao += TAM_CABECALHO_ENTRADA + tamanhoCorpo;
+    }
+    return posicao;
+}
+
+void DiarioEscrita::percorrer(const Visitante& visitar) const {
+    uint64_t ultimo = 0;
+    lerEntradas(&visitar, ultimo);
+}
+
+void DiarioEscrita::reiniciar() {
+    confirmar();
+    if (::ftruncate(descritor, 0) != 0 || ::fdatasync(descritor) != 0) {
+        throw std::runtime_error("DiarioEscrita: nao foi possivel esvaziar '" + caminho + "'.");
+    }
+    bytesValidos = 0;
+}
+
+void DiarioEscrita::avancarNumeracao(uint64_t numero) {
+    if (numero > ultimoNumero) {
+        ultimoNumero = numero;
+    }
+}
+
+uint64_t DiarioEscrita::getUltimoNumero() const {
+    return ultimoNumero;
+}
+
+size_t DiarioEscrita::getPendentes() const {
+    return pendentes;
+}
+
+size_t DiarioEscrita::getSincronizacoes() const {
+    return sincronizacoes;
+}
+
+size_t DiarioEscrita::getBytesDescartados() const {
+    return bytesDescartados;
+}
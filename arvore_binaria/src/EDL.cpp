@@ -1,12 +1,17 @@
 #include "EDL.h"
 #include <iostream>
 #include <stdexcept> // Para std::out_of_range
+#include <utility>   // Para std::move
 
 // Construtor padrão.
-EDL::EDL() {
+EDL::EDL() : quantidadeLivres(0) {
     // Apenas para depuração: std::cout << "EDL criada." << std::endl;
 }
 
+// O vetor é movido para dentro da EDL: nenhum Registro é copiado.
+EDL::EDL(std::vector<Registro> registros)
+    : dados(std::move(registros)), naListaLivre(dados.size(), false), quantidadeLivres(0) {}
+
 // Implementação da busca por posição para acesso constante.
 const Registro& EDL::buscarPorPosicao(int indice) const {
     // Validação do índice para evitar acesso fora dos limites.
@@ -28,15 +33,94 @@ Registro& EDL::buscarPorPosicaoParaModificacao(int indice) {
 
 // Implementação da inserção de um novo registro.
 int EDL::inserirRegistro(const Registro& novoRegistro) {
+    descartarLivresInvalidas();
+    if (!posicoesLivres.empty() && !novoRegistro.isDeletado()) {
+        // Reaproveita a posição de um registro removido.
+        int posicao = posicoesLivres.top();
+        posicoesLivres.pop();
+        naListaLivre[posicao] = false;
+        --quantidadeLivres;
+        dados[posicao].restaurarRegistro(novoRegistro.getCpf(), novoRegistro.getNome(),
+                                         novoRegistro.getDataNascimento(), novoRegistro.getSexo());
+        return posicao;
+    }
     dados.push_back(novoRegistro); // Adiciona o registro ao final do vetor.
+    naListaLivre.push_back(false);
     return dados.size() - 1;       // Retorna o índice onde o registro foi inserido.
 }
 
+void EDL::removerRegistro(int indice) {
+    Registro& registro = buscarPorPosicaoParaModificacao(indice);
+    if (registro.isDeletado()) {
+        return;
+    }
+    registro.marcarComoDeletado();
+    posicoesLivres.push(indice);
+    naListaLivre[indice] = true;
+    ++quantidadeLivres;
+}
+
+size_t EDL::getPosicoesLivres() const {
+    return quantidadeLivres;
+}
+
+void EDL::descartarLivresInvalidas() {
+    while (!posicoesLivres.empty() &&
+           (static_cast<size_t>(posicoesLivres.top()) >= dados.size() || !naListaLivre[posicoesLivres.top()])) {
+        posicoesLivres.pop();
+    }
+}
+
+// Cada passo faz uma quantidade limitada de trabalho, então a compactação pode ser
+// intercalada com as operações normais sem pausas longas.
+bool EDL::compactar(size_t maxPassos, const AoMoverRegistro& aoMover) {
+    for (size_t passo = 0; passo < maxPassos; ++passo) {
+        // Registros deletados no final não precisam ser movidos: basta descartá-los.
+        if (!dados.empty() && dados.back().isDeletado()) {
+            if (naListaLivre.back()) {
+                --quantidadeLivres;
+            }
+            dados.pop_back();
+            naListaLivre.pop_back();
+            continue;
+        }
+
+        descartarLivresInvalidas();
+        if (posicoesLivres.empty()) {
+            return false; // Nenhum buraco antes do último registro ativo
+        }
+
+        // O último registro é ativo e a posição livre está antes dele: move-o para o buraco.
+        int destino = posicoesLivres.top();
+        posicoesLivres.pop();
+        naListaLivre[destino] = false;
+        --quantidadeLivres;
+        int origem = static_cast<int>(dados.size() - 1);
+        dados[destino] = std::move(dados.back());
+        dados.pop_back();
+        naListaLivre.pop_back();
+        if (aoMover) {
+            aoMover(dados[destino], origem, destino);
+        }
+    }
+    descartarLivresInvalidas();
+    return !posicoesLivres.empty() || (!dados.empty() && dados.back().isDeletado());
+}
+
 // Retorna o tamanho atual da EDL.
 size_t EDL::getTamanho() const {
     return dados.size();
 }
 
+// Capacidade reservada do vetor mais o heap de cada Registro.
+size_t EDL::getMemoriaBytes() const {
+    size_t bytes = dados.capacity() * sizeof(Registro);
+    for (size_t i = 0; i < dados.size(); ++i) {
+        bytes += dados[i].getBytesHeap();
+    }
+    return bytes;
+}
+
 // Imprime todos os registros na EDL.
 void EDL::imprimirTodosRegistros() const {
     std::cout << "\n--- Conteúdo da EDL (Arquivo de Registros) ---" << std::endl;
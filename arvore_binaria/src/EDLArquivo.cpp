@@ -0,0 +1,196 @@
+#include "EDLArquivo.h"
+#include <algorithm> // Para std::max
+#include <cstring>   // Para std::memcpy, std::memset, std::memcmp
+#include <iostream>
+#include <stdexcept> // Para std::out_of_range, std::runtime_error, std::length_error
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap, munmap, msync
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para ftruncate, close
+
+namespace {
+
+const char ASSINATURA[8] = {'E', 'D', 'L', 'A', 'R', 'Q', '0', '1'};
+const uint32_t VERSAO_FORMATO = 1;
+
+// Capacidade inicial de um arquivo novo, em registros.
+const size_t CAPACIDADE_INICIAL = 1024;
+
+// Copia 'valor' para um campo fixo, completando com '\0'.
+void gravarCampo(char* destino, size_t tamanho, const std::string& valor, const char* nomeCampo) {
+    if (valor.size() > tamanho) {
+        throw std::length_error(std::string("EDLArquivo: campo '") + nomeCampo + "' excede "
+                                + std::to_string(tamanho) + " caracteres: '" + valor + "'.");
+    }
+    std::memset(destino, 0, tamanho);
+    std::memcpy(destino, valor.data(), valor.size());
+}
+
+} // namespace
+
+// RegistroArquivo
+
+std::string RegistroArquivo::campo(const char* texto, size_t tamanho) {
+    size_t comprimento = 0;
+    while (comprimento < tamanho && texto[comprimento] != '\0') {
+        ++comprimento;
+    }
+    return std::string(texto, comprimento);
+}
+
+void RegistroArquivo::marcarComoDeletado() {
+    deletado = 1;
+    std::memset(nome, 0, TAM_NOME);
+    std::memset(dataNascimento, 0, TAM_DATA);
+    sexo = ' ';
+}
+
+Registro RegistroArquivo::paraRegistro() const {
+    Registro registro(getCpf(), getNome(), getDataNascimento(), sexo);
+    if (isDeletado()) {
+        registro.marcarComoDeletado();
+    }
+    return registro;
+}
+
+void RegistroArquivo::imprimir() const {
+    paraRegistro().imprimir();
+}
+
+// EDLArquivo
+
+// Abre (ou cria) o arquivo e valida o cabeçalho.
+EDLArquivo::EDLArquivo(const std::string& caminho)
+    : caminho(caminho), descritor(-1), mapa(nullptr), bytesMapeados(0) {
+    descritor = ::open(caminho.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descritor < 0) {
+        throw std::runtime_error("EDLArquivo: nao foi possivel abrir '" + caminho + "'.");
+    }
+
+    struct stat info;
+    if (::fstat(descritor, &info) != 0) {
+        ::close(descritor);
+        throw std::runtime_error("EDLArquivo: nao foi possivel ler o tamanho de '" + caminho + "'.");
+    }
+
+    try {
+        if (info.st_size == 0) {
+            // Arquivo novo: reserva espaço para os primeiros registros e grava o cabeçalho.
+            remapear(sizeof(Cabecalho) + CAPACIDADE_INICIAL * TAM_REGISTRO_ARQUIVO);
+            Cabecalho* c = cabecalho();
+            std::memcpy(c->assinatura, ASSINATURA, sizeof(ASSINATURA));
+            c->versao = VERSAO_FORMATO;
+            c->tamanhoRegistro = TAM_REGISTRO_ARQUIVO;
+            c->quantidade = 0;
+        } else {
+            if (static_cast<size_t>(info.st_size) < sizeof(Cabecalho)) {
+                throw std::runtime_error("EDLArquivo: '" + caminho + "' e menor que o cabecalho.");
+            }
+            remapear(static_cast<size_t>(info.st_size));
+            Cabecalho* c = cabecalho();
+            if (std::memcmp(c->assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0 ||
+                c->versao != VERSAO_FORMATO || c->tamanhoRegistro != TAM_REGISTRO_ARQUIVO) {
+                throw std::runtime_error("EDLArquivo: '" + caminho + "' nao e um arquivo de registros valido.");
+            }
+            if (c->quantidade > capacidade()) {
+                throw std::runtime_error("EDLArquivo: '" + caminho + "' esta truncado.");
+            }
+        }
+    } catch (...) {
+        if (mapa != nullptr) {
+            ::munmap(mapa, bytesMapeados);
+        }
+        ::close(descritor);
+        throw;
+    }
+}
+
+// Ao fechar, o espaço reservado e não usado é devolvido (o arquivo fica com o tamanho exato).
+EDLArquivo::~EDLArquivo() {
+    size_t bytesUsados = sizeof(Cabecalho) + getTamanho() * TAM_REGISTRO_ARQUIVO;
+    ::msync(mapa, bytesMapeados, MS_SYNC);
+    ::munmap(mapa, bytesMapeados);
+    if (::ftruncate(descritor, static_cast<off_t>(bytesUsados)) != 0) {
+        std::cout << "ERRO: nao foi possivel ajustar o tamanho de '" << caminho << "'." << std::endl;
+    }
+    ::close(descritor);
+}
+
+size_t EDLArquivo::capacidade() const {
+    return (bytesMapeados - sizeof(Cabecalho)) / TAM_REGISTRO_ARQUIVO;
+}
+
+// O mapeamento antigo só é desfeito depois que o novo deu certo: se algo falhar,
+// a EDL continua válida com a capacidade anterior.
+void EDLArquivo::remapear(size_t bytes) {
+    if (bytes > bytesMapeados && ::ftruncate(descritor, static_cast<off_t>(bytes)) != 0) {
+        throw std::runtime_error("EDLArquivo: nao foi possivel redimensionar '" + caminho + "'.");
+    }
+    void* endereco = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descritor, 0);
+    if (endereco == MAP_FAILED) {
+        throw std::runtime_error("EDLArquivo: nao foi possivel mapear '" + caminho + "'.");
+    }
+    if (mapa != nullptr) {
+        ::munmap(mapa, bytesMapeados);
+    }
+    mapa = static_cast<char*>(endereco);
+    bytesMapeados = bytes;
+}
+
+// Busca por posição: validação do índice e uma conta de endereço, sem cópia.
+const RegistroArquivo& EDLArquivo::buscarPorPosicao(int indice) const {
+    if (indice < 0 || static_cast<size_t>(indice) >= getTamanho()) {
+        throw std::out_of_range("EDLArquivo::buscarPorPosicao (const): Indice fora dos limites.");
+    }
+    return registros()[indice];
+}
+
+RegistroArquivo& EDLArquivo::buscarPorPosicaoParaModificacao(int indice) {
+    if (indice < 0 || static_cast<size_t>(indice) >= getTamanho()) {
+        throw std::out_of_range("EDLArquivo::buscarPorPosicaoParaModificacao: Indice fora dos limites.");
+    }
+    return registros()[indice];
+}
+
+// Inserção no final. Quando o espaço reservado acaba, o arquivo dobra de tamanho,
+// o que mantém a inserção em O(1) amortizado, como no std::vector.
+int EDLArquivo::inserirRegistro(const Registro& novoRegistro) {
+    RegistroArquivo novo;
+    gravarCampo(novo.cpf, RegistroArquivo::TAM_CPF, novoRegistro.getCpf(), "cpf");
+    gravarCampo(novo.dataNascimento, RegistroArquivo::TAM_DATA, novoRegistro.getDataNascimento(), "dataNascimento");
+    gravarCampo(novo.nome, RegistroArquivo::TAM_NOME, novoRegistro.getNome(), "nome");
+    novo.sexo = novoRegistro.getSexo();
+    novo.deletado = novoRegistro.isDeletado() ? 1 : 0;
+
+    size_t posicao = getTamanho();
+    if (posicao == capacidade()) {
+        size_t novaCapacidade = std::max(CAPACIDADE_INICIAL, 2 * capacidade());
+        remapear(sizeof(Cabecalho) + novaCapacidade * TAM_REGISTRO_ARQUIVO);
+    }
+    registros()[posicao] = novo;
+    cabecalho()->quantidade = posicao + 1;
+    return static_cast<int>(posicao);
+}
+
+size_t EDLArquivo::getTamanho() const {
+    return static_cast<size_t>(cabecalho()->quantidade);
+}
+
+void EDLArquivo::imprimirTodosRegistros() const {
+    std::cout << "\n--- Conteúdo da EDL em arquivo (" << caminho << ") ---" << std::endl;
+    if (getTamanho() == 0) {
+        std::cout << "EDL vazia." << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < getTamanho(); ++i) {
+        std::cout << "Pos [" << i << "]: ";
+        registros()[i].imprimir();
+    }
+    std::cout << "------------------------------------------" << std::endl;
+}
+
+void EDLArquivo::sincronizar() {
+    if (::msync(mapa, bytesMapeados, MS_SYNC) != 0) {
+        throw std::runtime_error("EDLArquivo: falha ao gravar '" + caminho + "' no disco.");
+    }
+}
@@ -0,0 +1,159 @@
+#include "EDLColunar.h"
+#include <cstring>   // Para std::memcpy, std::memset
+#include <functional> // Para std::hash<std::string_view>
+#include <iostream>
+#include <limits>    // Para std::numeric_limits
+#include <stdexcept> // Para std::out_of_range, std::length_error
+
+// RegistroColunar: cada getter lê uma única coluna.
+
+std::string RegistroColunar::getCpf() const {
+    return edl->cpfs[posicao].formatar();
+}
+
+ChaveCPF RegistroColunar::getChaveCPF() const {
+    return edl->cpfs[posicao];
+}
+
+std::string_view RegistroColunar::getNome() const {
+    return edl->nomeDoIdentificador(edl->nomes[posicao]);
+}
+
+std::string_view RegistroColunar::getDataNascimento() const {
+    const char* data = &edl->datas[posicao * EDLColunar::TAM_DATA];
+    size_t comprimento = 0;
+    while (comprimento < EDLColunar::TAM_DATA && data[comprimento] != '\0') {
+        ++comprimento;
+    }
+    return std::string_view(data, comprimento);
+}
+
+char RegistroColunar::getSexo() const {
+    return edl->sexos[posicao];
+}
+
+bool RegistroColunar::isDeletado() const {
+    return edl->deletados[posicao] != 0;
+}
+
+Registro RegistroColunar::paraRegistro() const {
+    Registro registro(getCpf(), std::string(getNome()), std::string(getDataNascimento()), getSexo());
+    if (isDeletado()) {
+        registro.marcarComoDeletado();
+    }
+    return registro;
+}
+
+void RegistroColunar::imprimir() const {
+    paraRegistro().imprimir();
+}
+
+// EDLColunar
+
+// O nome vazio (usado pelos registros deletados) é sempre o identificador 0.
+EDLColunar::EDLColunar() {
+    inicioNomes.push_back(0);
+    internarNome(std::string_view());
+}
+
+uint32_t EDLColunar::internarNome(std::string_view nome) {
+    size_t hash = std::hash<std::string_view>()(nome);
+    auto faixa = nomesPorHash.equal_range(hash);
+    for (auto it = faixa.first; it != faixa.second; ++it) {
+        if (nomeDoIdentificador(it->second) == nome) {
+            return it->second; // Nome já internado
+        }
+    }
+
+    // Os deslocamentos são de 32 bits: o repositório comporta até 4 GiB de nomes distintos.
+    if (repositorioNomes.size() + nome.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("EDLColunar: repositorio de nomes excede 4 GiB.");
+    }
+    uint32_t id = static_cast<uint32_t>(inicioNomes.size() - 1);
+    repositorioNomes.append(nome.data(), nome.size());
+    inicioNomes.push_back(static_cast<uint32_t>(repositorioNomes.size()));
+    nomesPorHash.emplace(hash, id);
+    return id;
+}
+
+std::string_view EDLColunar::nomeDoIdentificador(uint32_t id) const {
+    return std::string_view(repositorioNomes.data() + inicioNomes[id], inicioNomes[id + 1] - inicioNomes[id]);
+}
+
+void EDLColunar::validarIndice(int indice, const char* metodo) const {
+    if (indice < 0 || static_cast<size_t>(indice) >= cpfs.size()) {
+        throw std::out_of_range(std::string("EDLColunar::") + metodo + ": Indice fora dos limites.");
+    }
+}
+
+// Inserção: um valor no final de cada coluna. Tudo é validado antes de alterar
+// qualquer coluna, para que elas continuem com o mesmo tamanho em caso de erro.
+int EDLColunar::inserirRegistro(const Registro& novoRegistro) {
+    ChaveCPF cpf(novoRegistro.getCpf());
+    std::string data = novoRegistro.getDataNascimento();
+    if (data.size() > TAM_DATA) {
+        throw std::length_error("EDLColunar: data de nascimento com mais de " + std::to_string(TAM_DATA)
+                                + " caracteres: '" + data + "'.");
+    }
+    uint32_t nome = internarNome(novoRegistro.getNome());
+
+    cpfs.push_back(cpf);
+    size_t inicioData = datas.size();
+    datas.resize(inicioData + TAM_DATA, '\0');
+    std::memcpy(&datas[inicioData], data.data(), data.size());
+    sexos.push_back(novoRegistro.getSexo());
+    deletados.push_back(novoRegistro.isDeletado() ? 1 : 0);
+    nomes.push_back(nome);
+    return static_cast<int>(cpfs.size() - 1);
+}
+
+RegistroColunar EDLColunar::buscarPorPosicao(int indice) const {
+    validarIndice(indice, "buscarPorPosicao");
+    return RegistroColunar(*this, static_cast<size_t>(indice));
+}
+
+// O nome continua no repositório (pode ser usado por outros registros); o registro
+// apenas passa a apontar para o nome vazio.
+void EDLColunar::marcarComoDeletado(int indice) {
+    validarIndice(indice, "marcarComoDeletado");
+    deletados[indice] = 1;
+    nomes[indice] = 0;
+    std::memset(&datas[indice * TAM_DATA], 0, TAM_DATA);
+    sexos[indice] = ' ';
+}
+
+size_t EDLColunar::getTamanho() const {
+    return cpfs.size();
+}
+
+void EDLColunar::imprimirTodosRegistros() const {
+    std::cout << "\n--- Conteúdo da EDL colunar (Arquivo de Registros) ---" << std::endl;
+    if (cpfs.empty()) {
+        std::cout << "EDL vazia." << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < cpfs.size(); ++i) {
+        std::cout << "Pos [" << i << "]: ";
+        RegistroColunar(*this, i).imprimir();
+    }
+    std::cout << "------------------------------------------" << std::endl;
+}
+
+size_t EDLColunar::getNomesDistintos() const {
+    return inicioNomes.size() - 1;
+}
+
+// Soma a capacidade reservada de cada coluna. Para a tabela de internação, estima
+// cada nó do multimap como o par (hash, id) mais o ponteiro do encadeamento, além do vetor de baldes.
+size_t EDLColunar::getMemoriaBytes() const {
+    size_t bytes = cpfs.capacity() * sizeof(ChaveCPF)
+                 + datas.capacity()
+                 + sexos.capacity()
+                 + deletados.capacity()
+                 + nomes.capacity() * sizeof(uint32_t)
+                 + repositorioNomes.capacity()
+                 + inicioNomes.capacity() * sizeof(uint32_t);
+    bytes += nomesPorHash.size() * (sizeof(std::pair<const size_t, uint32_t>) + sizeof(void*) + sizeof(size_t));
+    bytes += nomesPorHash.bucket_count() * sizeof(void*);
+    return bytes;
+}
@@ -0,0 +1,198 @@
+#include "Indexacao.h"
+#include <algorithm> // Para std::min, std::move
+#include <thread>    // Para a geração paralela da EDL ordenada
+#include <vector>
+
+namespace {
+
+// Chaves por bloco em buscarRegistrosEmLote: os registros de um bloco são trazidos
+// para o cache juntos, então o bloco deve caber com folga no cache L2.
+const size_t CHAVES_POR_BLOCO = 256;
+
+// Abaixo deste número de registros por thread, criar threads não compensa.
+const size_t MIN_REGISTROS_POR_THREAD = 1 << 14;
+
+// Chave do índice de um registro: Registro e RegistroArquivo guardam o CPF como texto,
+// que é convertido; a EDLColunar já guarda a ChaveCPF, usada sem passar por texto.
+template <typename RegistroOrigem>
+ChaveCPF chaveDoRegistro(const RegistroOrigem& registro) {
+    return ChaveCPF(registro.getCpf());
+}
+
+ChaveCPF chaveDoRegistro(const RegistroColunar& registro) {
+    return registro.getChaveCPF();
+}
+
+// Reconstrução do índice (ABB ou ArvoreBMais) a partir de qualquer EDL com
+// buscarPorPosicao/getTamanho (EDL em memória, EDLArquivo ou EDLColunar).
+template <typename Indice, typename EDLOrigem>
+void reconstruirIndiceDe(Indice& indice, const EDLOrigem& edl) {
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(edl.getTamanho());
+    for (size_t i = 0; i < edl.getTamanho(); ++i) {
+        const auto& registro = edl.buscarPorPosicao(static_cast<int>(i));
+        if (!registro.isDeletado()) {
+            entradas.push_back(EntradaIndice(chaveDoRegistro(registro), static_cast<int>(i)));
+        }
+    }
+    // As posições são crescentes, mas os CPFs não: a carga em lote ordena.
+    indice.carregarEmLote(std::move(entradas), false);
+}
+
+template <typename Indice>
+bool removerPorCPFDe(Indice& indice, EDL& edl, const ChaveCPF& cpf) {
+    int posicao = indice.buscarPosicao(cpf);
+    if (posicao == -1) {
+        return false;
+    }
+    indice.remover(cpf);
+    edl.removerRegistro(posicao);
+    return true;
+}
+
+// Posições de um bloco de chaves: a ABB tem busca em lote; na Árvore B+, cada busca
+// já toca poucos nós.
+void buscarPosicoesDoBloco(const ABB& indice, const ChaveCPF* cpfs, size_t numeroChaves, int* posicoes) {
+    indice.buscarPosicoes(cpfs, numeroChaves, posicoes);
+}
+
+void buscarPosicoesDoBloco(const ArvoreBMais& indice, const ChaveCPF* cpfs, size_t numeroChaves, int* posicoes) {
+    for (size_t i = 0; i < numeroChaves; ++i) {
+        posicoes[i] = indice.buscarPosicao(cpfs[i]);
+    }
+}
+
+// Busca em lote: índice e EDL são consultados bloco a bloco.
+template <typename Indice>
+void buscarRegistrosEmLoteDe(const Indice& indice, const EDL& edl, const std::vector<ChaveCPF>& cpfs,
+                             std::vector<int>& posicoes, std::vector<const Registro*>& registros) {
+    posicoes.resize(cpfs.size());
+    registros.assign(cpfs.size(), nullptr);
+    for (size_t inicio = 0; inicio < cpfs.size(); inicio += CHAVES_POR_BLOCO) {
+        size_t tamanhoBloco = std::min(CHAVES_POR_BLOCO, cpfs.size() - inicio);
+        buscarPosicoesDoBloco(indice, &cpfs[inicio], tamanhoBloco, &posicoes[inicio]);
+
+        // Primeiro passo: dispara a leitura de todos os registros do bloco.
+        for (size_t i = inicio; i < inicio + tamanhoBloco; ++i) {
+            if (posicoes[i] != -1) {
+                registros[i] = &edl.buscarPorPosicao(posicoes[i]);
+#if defined(__GNUC__)
+                __builtin_prefetch(registros[i], 0, 3);
+#endif
+            }
+        }
+        // Segundo passo: os registros já estão (ou estão chegando) no cache.
+        for (size_t i = inicio; i < inicio + tamanhoBloco; ++i) {
+            if (registros[i] != nullptr && registros[i]->isDeletado()) {
+                registros[i] = nullptr;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void reconstruirIndice(ABB& indice, const EDL& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+void reconstruirIndice(ABB& indice, const EDLArquivo& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+void reconstruirIndice(ABB& indice, const EDLColunar& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+void reconstruirIndice(ArvoreBMais& indice, const EDL& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+void reconstruirIndice(ArvoreBMais& indice, const EDLArquivo& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+void reconstruirIndice(ArvoreBMais& indice, const EDLColunar& edl) {
+    reconstruirIndiceDe(indice, edl);
+}
+
+bool removerPorCPF(ABB& indice, EDL& edl, const ChaveCPF& cpf) {
+    return removerPorCPFDe(indice, edl, cpf);
+}
+
+bool removerPorCPF(ArvoreBMais& indice, EDL& edl, const ChaveCPF& cpf) {
+    return removerPorCPFDe(indice, edl, cpf);
+}
+
+// Só a entrada que aponta para a posição antiga é corrigida: um registro com CPF repetido
+// que não está no índice (recusado na inserção) pode ser movido sem afetar o índice.
+bool compactarEDL(EDL& edl, ABB& indice, size_t maxPassos) {
+    return edl.compactar(maxPassos, [&indice](const Registro& registro, int posicaoAntiga, int posicaoNova) {
+        indice.atualizarPosicao(registro.getCpf(), posicaoAntiga, posicaoNova);
+    });
+}
+
+// Cada thread recebe a faixa de ordens [inicio, fim) do percurso: posiciona um iterador
+// na ordem 'inicio' em O(log n) e escreve os registros a partir de saida[inicio], então
+// as threads nunca escrevem na mesma posição e não precisam se sincronizar.
+EDL gerarEDLOrdenada(const ABB& indice, const EDL& edl, size_t threads) {
+    size_t n = indice.getTamanho();
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<size_t>(1, n / MIN_REGISTROS_POR_THREAD));
+
+    std::vector<Registro> saida(n);
+    std::vector<size_t> limites(threads + 1);
+    std::vector<size_t> copiados(threads, 0); // Registros válidos em cada faixa
+    for (size_t t = 0; t <= threads; ++t) {
+        limites[t] = n * t / threads;
+    }
+
+    auto copiarFaixa = [&](size_t t) {
+        ABB::IteradorEmOrdem it = indice.iteradorNaOrdem(limites[t]);
+        size_t destino = limites[t];
+        for (size_t ordem = limites[t]; ordem < limites[t + 1]; ++ordem, ++it) {
+            int posicao = it->getPosicaoEDL();
+            if (posicao < 0 || static_cast<size_t>(posicao) >= edl.getTamanho()) {
+                continue;
+            }
+            const Registro& registro = edl.buscarPorPosicao(posicao);
+            if (!registro.isDeletado()) {
+                saida[destino++] = registro;
+            }
+        }
+        copiados[t] = destino - limites[t];
+    };
+
+    std::vector<std::thread> trabalhadores;
+    for (size_t t = 1; t < threads; ++t) {
+        trabalhadores.push_back(std::thread(copiarFaixa, t));
+    }
+    copiarFaixa(0); // A thread atual cuida da primeira faixa
+    for (size_t i = 0; i < trabalhadores.size(); ++i) {
+        trabalhadores[i].join();
+    }
+
+    // Se alguma entrada foi ignorada, as faixas têm buracos no final: junta as faixas
+    // movendo os registros (sem copiar os textos) e descarta o excesso.
+    size_t total = copiados[0];
+    for (size_t t = 1; t < threads; ++t) {
+        if (total != limites[t]) {
+            std::move(saida.begin() + limites[t], saida.begin() + limites[t] + copiados[t], saida.begin() + total);
+        }
+        total += copiados[t];
+    }
+    saida.resize(total);
+    return EDL(std::move(saida));
+}
+
+void buscarRegistrosEmLote(const ABB& indice, const EDL& edl, const std::vector<ChaveCPF>& cpfs,
+                           std::vector<int>& posicoes, std::vector<const Registro*>& registros) {
+    buscarRegistrosEmLoteDe(indice, edl, cpfs, posicoes, registros);
+}
+
+void buscarRegistrosEmLote(const ArvoreBMais& indice, const EDL& edl, const std::vector<ChaveCPF>& cpfs,
+                           std::vector<int>& posicoes, std::vector<const Registro*>& registros) {
+    buscarRegistrosEmLoteDe(indice, edl, cpfs, posicoes, registros);
+}
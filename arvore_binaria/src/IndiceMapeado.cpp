@@ -0,0 +1,172 @@
+#include "persistencia/IndiceMapeado.h"
+#include "persistencia/Serializacao.h"
+#include <algorithm> // Para std::lower_bound, std::upper_bound
+#include <cstdio>    // Para std::rename
+#include <cstring>   // Para std::memcpy, std::memset, std::memcmp
+#include <stdexcept> // Para std::runtime_error, std::invalid_argument
+#include <utility>   // Para std::move
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap, munmap
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para fsync, close
+
+namespace {
+
+const char ASSINATURA_INDICE[8] = {'A', 'B', 'B', 'I', 'D', 'X', '0', '1'};
+const uint32_t VERSAO_INDICE = 1;
+
+// Cabeçalho da fotografia; os 64 bytes mantêm o vetor de chaves alinhado.
+struct CabecalhoIndice {
+    char assinatura[8];
+    uint32_t versao;
+    uint32_t bytesPorEntrada;
+    uint64_t quantidade;
+    char reservado[40];
+};
+static_assert(sizeof(CabecalhoIndice) == 64, "CabecalhoIndice deve ter 64 bytes");
+
+const size_t BYTES_POR_ENTRADA = sizeof(uint64_t) + sizeof(int32_t);
+
+// Bytes acumulados antes de cada chamada a write.
+const size_t BYTES_POR_GRAVACAO = 1 << 20;
+
+// Diretório que contém 'caminho' ("." se não houver barra).
+std::string diretorioDe(const std::string& caminho) {
+    size_t barra = caminho.find_last_of('/');
+    if (barra == std::string::npos) {
+        return ".";
+    }
+    return barra == 0 ? "/" : caminho.substr(0, barra);
+}
+
+} // namespace
+
+// Um único percurso em ordem: as chaves vão para o arquivo por um buffer de tamanho fixo,
+// e as posições (4 bytes por entrada) são guardadas em memória e gravadas depois delas.
+void salvarIndice(const ABB& indice, const std::string& caminho) {
+    std::string temporario = caminho + ".tmp";
+    int descritor = ::open(temporario.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descritor < 0) {
+        throw std::runtime_error("salvarIndice: nao foi possivel criar '" + temporario + "'.");
+    }
+    try {
+        CabecalhoIndice cabecalho;
+        std::memset(&cabecalho, 0, sizeof(cabecalho));
+        std::memcpy(cabecalho.assinatura, ASSINATURA_INDICE, sizeof(ASSINATURA_INDICE));
+        cabecalho.versao = VERSAO_INDICE;
+        cabecalho.bytesPorEntrada = BYTES_POR_ENTRADA;
+        cabecalho.quantidade = indice.getTamanho();
+        gravarTudo(descritor, reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho), temporario);
+
+        std::string chaves;
+        chaves.reserve(BYTES_POR_GRAVACAO);
+        std::vector<int32_t> posicoes;
+        posicoes.reserve(indice.getTamanho());
+        for (const EntradaIndice& entrada : indice) {
+            acrescentarValor(chaves, entrada.getChave().getValor());
+            posicoes.push_back(static_cast<int32_t>(entrada.getPosicaoEDL()));
+            if (chaves.size() >= BYTES_POR_GRAVACAO) {
+                gravarTudo(descritor, chaves.data(), chaves.size(), temporario);
+                chaves.clear();
+            }
+        }
+        gravarTudo(descritor, chaves.data(), chaves.size(), temporario);
+        gravarTudo(descritor, reinterpret_cast<const char*>(posicoes.data()),
+                   posicoes.size() * sizeof(int32_t), temporario);
+        if (::fsync(descritor) != 0) {
+            throw std::runtime_error("salvarIndice: falha ao sincronizar '" + temporario + "'.");
+        }
+    } catch (...) {
+        ::close(descritor);
+        std::remove(temporario.c_str());
+        throw;
+    }
+    ::close(descritor);
+    if (std::rename(temporario.c_str(), caminho.c_str()) != 0) {
+        std::remove(temporario.c_str());
+        throw std::runtime_error("salvarIndice: nao foi possivel substituir '" + caminho + "'.");
+    }
+    sincronizarDiretorio(diretorioDe(caminho));
+}
+
+// A carga em lote confia na ordem das entradas, e a fotografia não tem soma de verificação:
+// cada chave (no máximo 11 dígitos), cada posição (não negativa) e a ordem estritamente
+// crescente são conferidas na mesma passagem da cópia, antes de alterar o índice.
+void carregarIndice(ABB& indice, const std::string& caminho) {
+    IndiceMapeado fotografia(caminho);
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(fotografia.getTamanho());
+    for (size_t i = 0; i < fotografia.getTamanho(); ++i) {
+        try {
+            entradas.push_back(fotografia.getEntrada(i));
+        } catch (const std::invalid_argument&) {
+            throw std::runtime_error("carregarIndice: '" + caminho + "' tem uma chave que nao e um CPF.");
+        }
+        if (entradas[i].getPosicaoEDL() < 0) {
+            throw std::runtime_error("carregarIndice: '" + caminho + "' tem uma posicao negativa na EDL.");
+        }
+        if (i > 0 && !(entradas[i - 1] < entradas[i])) {
+            throw std::runtime_error("carregarIndice: '" + caminho + "' nao esta em ordem crescente de CPF.");
+        }
+    }
+    indice.carregarEmLote(std::move(entradas), true);
+}
+
+// IndiceMapeado
+
+IndiceMapeado::IndiceMapeado(const std::string& caminho)
+    : caminho(caminho), mapa(nullptr), bytesMapeados(0), quantidade(0), chaves(nullptr), posicoes(nullptr) {
+    int descritor = ::open(caminho.c_str(), O_RDONLY);
+    if (descritor < 0) {
+        throw std::runtime_error("IndiceMapeado: nao foi possivel abrir '" + caminho + "'.");
+    }
+    struct stat info;
+    if (::fstat(descritor, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CabecalhoIndice)) {
+        ::close(descritor);
+        throw std::runtime_error("IndiceMapeado: '" + caminho + "' nao e uma fotografia de indice valida.");
+    }
+    bytesMapeados = static_cast<size_t>(info.st_size);
+    mapa = ::mmap(nullptr, bytesMapeados, PROT_READ, MAP_PRIVATE, descritor, 0);
+    ::close(descritor); // O mapeamento continua válido depois de fechar o descritor
+    if (mapa == MAP_FAILED) {
+        mapa = nullptr;
+        throw std::runtime_error("IndiceMapeado: nao foi possivel mapear '" + caminho + "'.");
+    }
+
+    const CabecalhoIndice* cabecalho = static_cast<const CabecalhoIndice*>(mapa);
+    if (std::memcmp(cabecalho->assinatura, ASSINATURA_INDICE, sizeof(ASSINATURA_INDICE)) != 0 ||
+        cabecalho->versao != VERSAO_INDICE || cabecalho->bytesPorEntrada != BYTES_POR_ENTRADA ||
+        cabecalho->quantidade > (bytesMapeados - sizeof(CabecalhoIndice)) / BYTES_POR_ENTRADA ||
+        sizeof(CabecalhoIndice) + cabecalho->quantidade * BYTES_POR_ENTRADA != bytesMapeados) {
+        ::munmap(mapa, bytesMapeados);
+        throw std::runtime_error("IndiceMapeado: '" + caminho + "' nao e uma fotografia de indice valida.");
+    }
+    quantidade = static_cast<size_t>(cabecalho->quantidade);
+    const char* dados = static_cast<const char*>(mapa) + sizeof(CabecalhoIndice);
+    chaves = reinterpret_cast<const uint64_t*>(dados);
+    posicoes = reinterpret_cast<const int32_t*>(dados + quantidade * sizeof(uint64_t));
+}
+
+IndiceMapeado::~IndiceMapeado() {
+    ::munmap(mapa, bytesMapeados);
+}
+
+int IndiceMapeado::buscarPosicao(const ChaveCPF& cpf) const {
+    const uint64_t* fim = chaves + quantidade;
+    const uint64_t* encontrada = std::lower_bound(chaves, fim, cpf.getValor());
+    if (encontrada == fim || *encontrada != cpf.getValor()) {
+        return -1;
+    }
+    return posicoes[encontrada - chaves];
+}
+
+std::vector<int> IndiceMapeado::buscarIntervalo(const ChaveCPF& inicio, const ChaveCPF& fim) const {
+    std::vector<int> resultado;
+    if (fim < inicio) {
+        return resultado;
+    }
+    const uint64_t* primeira = std::lower_bound(chaves, chaves + quantidade, inicio.getValor());
+    const uint64_t* ultima = std::upper_bound(primeira, chaves + quantidade, fim.getValor());
+    resultado.assign(posicoes + (primeira - chaves), posicoes + (ultima - chaves));
+    return resultado;
+}
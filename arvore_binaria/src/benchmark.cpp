@@ -0,0 +1,941 @@
+#include "abb/ABB.h"
+#include "bmais/ArvoreBMais.h"
+#include "BancoDados.h"
+#include "BaseConcorrente.h"
+#include "EDL.h"
+#include "EDLArquivo.h"
+#include "EDLColunar.h"
+#include "FiltroBloom.h"
+#include "Indexacao.h"
+#include "IndiceSecundario.h"
+#include "persistencia/IndiceMapeado.h"
+#include <algorithm> // Para std::sort
+#include <chrono>    // Para medir o tempo
+#include <cstdio>    // Para std::snprintf e std::remove
+#include <cstdlib>   // Para std::strtoull
+#include <atomic>    // Para o sinal de parada do escritor
+#include <iostream>
+#include <mutex>     // Para a base de referência com um mutex global
+#include <thread>
+#include <unistd.h>  // Para rmdir
+#include <string>
+#include <utility>   // Para std::move
+#include <vector>
+
+// Programa de benchmark dos índices.
+// Uso: ./build/benchmark <modo> [tamanhos...]
+//   indices: compara inserção e busca da ABB (simples e AVL) com a Árvore B+.
+//   carga:   compara n inserções na ABB AVL com a carga em lote (entrada ordenada e não ordenada).
+//   lote:    compara buscas individuais com a busca em lote (com prefetch), com e sem leitura da EDL.
+//   concorrente: mede a vazão de leitura com 1, 2, 4, ... threads, com e sem um escritor em paralelo,
+//                comparando a BaseConcorrente (Left-Right) com EDL + ABB protegidas por um mutex global.
+//   arquivo: mede a EDL em arquivo (mmap): gravação, reabertura, buscas por posição e reconstrução do índice.
+//   memoria: compara os bytes por registro da EDL (vetor de Registro) com a EDLColunar.
+//   intervalo: compara consultas por faixa e por prefixo, contagens e paginação com a varredura
+//              completa do índice.
+//   percurso: mede os iteradores e os percursos com visitante (sem recursão e sem iostream).
+//   ordenada: compara a geração da EDL ordenada registro a registro com gerarEDLOrdenada
+//             (reserva única e faixas do percurso copiadas em paralelo).
+//   fotografia: compara a partida a frio do índice (n inserções) com a fotografia em disco
+//               (gravação, recarga em O(n) e consultas direto no arquivo mapeado).
+//   wal:     mede o custo por operação do diário de escrita com confirmação em grupo
+//            (1, 8, 64 e 512 operações por fdatasync), o checkpoint e a recuperação.
+//   secundario: compara consultas por nome e por faixa de datas de nascimento nos índices
+//               secundários com a varredura da EDL, e mede a construção e a manutenção dos índices.
+//   filtro:  mede buscas de CPFs ausentes e presentes na ABB AVL sem filtro e com filtros de
+//            Bloom de 1%, 0,1% e 0,01%, com a taxa de falsos positivos medida e o tamanho do filtro.
+
+namespace {
+
+typedef std::chrono::steady_clock Relogio;
+
+// Segundos decorridos desde 'inicio'.
+double segundosDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double>(Relogio::now() - inicio).count();
+}
+
+// Formata um número de 11 dígitos como CPF ("111.111.111-11").
+std::string formatarCPF(unsigned long long numero) {
+    char texto[16];
+    std::snprintf(texto, sizeof(texto), "%03llu.%03llu.%03llu-%02llu",
+                  (numero / 100000000ULL) % 1000, (numero / 100000ULL) % 1000,
+                  (numero / 100ULL) % 1000, numero % 100);
+    return texto;
+}
+
+// Gera 'n' CPFs distintos em ordem pseudoaleatória.
+// i -> (i * A + B) mod 10^11 é uma bijeção porque A não é divisível por 2 nem por 5.
+std::vector<std::string> gerarCPFs(size_t n, unsigned long long semente) {
+    const unsigned long long MODULO = 100000000000ULL;
+    const unsigned long long A = 48271ULL * 1000003ULL; // Ímpar e não múltiplo de 5
+    std::vector<std::string> cpfs;
+    cpfs.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        unsigned long long valor = (static_cast<unsigned long long>(i) * A + semente) % MODULO;
+        cpfs.push_back(formatarCPF(valor));
+    }
+    return cpfs;
+}
+
+// Imprime uma linha de resultado em milhões de operações por segundo.
+void reportar(const std::string& estrutura, const std::string& operacao, size_t n, double segundos) {
+    std::cout << "  " << estrutura << " - " << operacao << ": " << segundos << " s ("
+              << (n / segundos) / 1e6 << " Mops/s)" << std::endl;
+}
+
+// Insere todas as chaves e depois busca todas em outra ordem.
+// 'Indice' é ABB, ABBTexto ou ArvoreBMais, que compartilham a mesma interface.
+template <typename Indice, typename Chave>
+void medirIndice(const std::string& nome, Indice& indice,
+                 const std::vector<Chave>& chaves, const std::vector<Chave>& consultas) {
+    Relogio::time_point inicio = Relogio::now();
+    for (size_t i = 0; i < chaves.size(); ++i) {
+        indice.inserir(EntradaIndiceGenerica<Chave>(chaves[i], static_cast<int>(i)));
+    }
+    reportar(nome, "insercao", chaves.size(), segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    long long soma = 0; // Evita que o compilador descarte as buscas
+    for (size_t i = 0; i < consultas.size(); ++i) {
+        soma += indice.buscarPosicao(consultas[i]);
+    }
+    reportar(nome, "busca", consultas.size(), segundosDesde(inicio));
+    std::cout << "  " << nome << " - altura: " << indice.getAltura()
+              << " (checksum " << soma << ")" << std::endl;
+}
+
+void benchmarkIndices(size_t n) {
+    std::cout << "\n=== Indices com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 12345);
+    // As consultas percorrem as mesmas chaves em outra permutação.
+    std::vector<std::string> consultasTexto;
+    consultasTexto.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        consultasTexto.push_back(textos[(i * 7919) % n]);
+    }
+
+    // O texto é convertido para ChaveCPF uma única vez, na borda, fora da medição.
+    std::vector<ChaveCPF> chaves(textos.begin(), textos.end());
+    std::vector<ChaveCPF> consultas(consultasTexto.begin(), consultasTexto.end());
+
+    {
+        ABBTexto abbTexto(TipoBalanceamento::AVL);
+        medirIndice("ABB AVL (chave texto)", abbTexto, textos, consultasTexto);
+    }
+    {
+        ABB abb(TipoBalanceamento::NENHUM);
+        medirIndice("ABB simples", abb, chaves, consultas);
+    }
+    {
+        ABB avl(TipoBalanceamento::AVL);
+        medirIndice("ABB AVL", avl, chaves, consultas);
+    }
+    {
+        ArvoreBMais arvoreB;
+        medirIndice("Arvore B+", arvoreB, chaves, consultas);
+    }
+}
+
+// Mede a construção de um índice com n chaves por inserções sucessivas e por carga em lote.
+void benchmarkCarga(size_t n) {
+    std::cout << "\n=== Construcao do indice com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 777);
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        entradas.push_back(EntradaIndice(textos[i], static_cast<int>(i)));
+    }
+    std::vector<EntradaIndice> ordenadas(entradas);
+    std::sort(ordenadas.begin(), ordenadas.end());
+
+    {
+        Relogio::time_point inicio = Relogio::now();
+        ABB avl(TipoBalanceamento::AVL);
+        for (size_t i = 0; i < entradas.size(); ++i) {
+            avl.inserir(entradas[i]);
+        }
+        reportar("ABB AVL", "n insercoes", n, segundosDesde(inicio));
+        std::cout << "  ABB AVL - altura: " << avl.getAltura() << std::endl;
+    }
+    {
+        std::vector<EntradaIndice> copia(entradas); // A cópia fica fora da medição
+        Relogio::time_point inicio = Relogio::now();
+        ABB lote(std::move(copia), false, TipoBalanceamento::AVL);
+        reportar("Carga em lote", "entrada nao ordenada", n, segundosDesde(inicio));
+        std::cout << "  Carga em lote - altura: " << lote.getAltura() << std::endl;
+    }
+    {
+        std::vector<EntradaIndice> copia(ordenadas); // A cópia fica fora da medição
+        Relogio::time_point inicio = Relogio::now();
+        ABB lote(std::move(copia), true, TipoBalanceamento::AVL);
+        reportar("Carga em lote", "entrada ordenada", n, segundosDesde(inicio));
+        std::cout << "  Carga em lote - altura: " << lote.getAltura() << std::endl;
+    }
+}
+
+// Mede os percursos de um índice com n CPFs montado por carga em lote.
+void benchmarkPercurso(size_t n) {
+    std::cout << "\n=== Percursos de um indice com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 4242);
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        entradas.push_back(EntradaIndice(textos[i], static_cast<int>(i)));
+    }
+    std::vector<std::string>().swap(textos); // Libera os textos antes das medições
+    ABB abb(std::move(entradas), false, TipoBalanceamento::AVL);
+
+    long long soma = 0; // Evita que o compilador descarte os percursos
+    Relogio::time_point inicio = Relogio::now();
+    for (const EntradaIndice& entrada : abb) {
+        soma += entrada.getPosicaoEDL();
+    }
+    reportar("Iterador", "em ordem", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    for (ABB::IteradorEmOrdem it = abb.rbegin(); it != abb.rend(); ++it) {
+        soma += it->getPosicaoEDL();
+    }
+    reportar("Iterador", "em ordem reversa", n, segundosDesde(inicio));
+
+    ABB::Visitante somar = [&soma](const EntradaIndice& entrada) { soma += entrada.getPosicaoEDL(); };
+    inicio = Relogio::now();
+    abb.visitarPreOrdem(somar);
+    reportar("Visitante", "pre-ordem", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    abb.visitarEmOrdem(somar);
+    reportar("Visitante", "em ordem", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    abb.visitarPosOrdem(somar);
+    reportar("Visitante", "pos-ordem", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    abb.visitarEmLargura(somar);
+    reportar("Visitante", "em largura", n, segundosDesde(inicio));
+    std::cout << "  (checksum " << soma << ")" << std::endl;
+}
+
+// Buscas de n CPFs (em ordem aleatória) em um índice e EDL com n registros:
+// laço de buscas individuais contra a busca em lote.
+void benchmarkLote(size_t n) {
+    std::cout << "\n=== Busca em lote em um indice com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 2024);
+    EDL edl;
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        int posicao = edl.inserirRegistro(Registro(textos[i], "Pessoa " + std::to_string(i), "01/01/1990", 'F'));
+        entradas.push_back(EntradaIndice(textos[i], posicao));
+    }
+    ABB abb(std::move(entradas), false, TipoBalanceamento::AVL);
+
+    // Consultas: as mesmas chaves em outra permutação, já convertidas para ChaveCPF.
+    std::vector<ChaveCPF> consultas;
+    consultas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        consultas.push_back(textos[(i * 7919) % n]);
+    }
+    std::vector<std::string>().swap(textos);
+
+    long long soma = 0; // Evita que o compilador descarte as buscas
+    Relogio::time_point inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        soma += abb.buscarPosicao(consultas[i]);
+    }
+    reportar("Buscas individuais", "posicao", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    std::vector<int> posicoes = abb.buscarPosicoes(consultas);
+    reportar("Busca em lote", "posicao", n, segundosDesde(inicio));
+    for (size_t i = 0; i < n; ++i) {
+        soma -= posicoes[i]; // Mesmas respostas: a soma volta a zero
+    }
+
+    size_t ativos = 0;
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        int posicao = abb.buscarPosicao(consultas[i]);
+        if (posicao != -1 && !edl.buscarPorPosicao(posicao).isDeletado()) {
+            ++ativos;
+        }
+    }
+    reportar("Buscas individuais", "posicao + registro", n, segundosDesde(inicio));
+
+    std::vector<const Registro*> registros;
+    inicio = Relogio::now();
+    buscarRegistrosEmLote(abb, edl, consultas, posicoes, registros);
+    for (size_t i = 0; i < n; ++i) {
+        ativos -= registros[i] != nullptr;
+    }
+    reportar("Busca em lote", "posicao + registro", n, segundosDesde(inicio));
+    std::cout << "  (checksum " << soma << ", diferenca " << ativos << ")" << std::endl;
+}
+
+// Base de referência: EDL + ABB protegidas por um único mutex (leituras também travam).
+class BaseComMutex {
+private:
+    mutable std::mutex trava;
+    BaseDados dados;
+
+public:
+    void inserir(const Registro& registro) {
+        std::lock_guard<std::mutex> guarda(trava);
+        int posicao = dados.registros.inserirRegistro(registro);
+        dados.indice.inserir(EntradaIndice(registro.getCpf(), posicao));
+    }
+
+    void remover(const ChaveCPF& cpf) {
+        std::lock_guard<std::mutex> guarda(trava);
+        int posicao = dados.indice.buscarPosicao(cpf);
+        if (posicao != -1) {
+            dados.registros.buscarPorPosicaoParaModificacao(posicao).marcarComoDeletado();
+            dados.indice.remover(cpf);
+        }
+    }
+
+    bool buscarRegistro(const ChaveCPF& cpf, Registro& resultado) const {
+        std::lock_guard<std::mutex> guarda(trava);
+        int posicao = dados.indice.buscarPosicao(cpf);
+        if (posicao == -1) {
+            return false;
+        }
+        resultado = dados.registros.buscarPorPosicao(posicao);
+        return true;
+    }
+};
+
+// Roda 'leitores' threads, cada uma buscando 'buscasPorThread' CPFs (busca no índice +
+// cópia do registro), opcionalmente com uma thread escritora inserindo e removendo
+// CPFs novos até os leitores terminarem. Reporta a vazão somada dos leitores.
+template <typename Base>
+void medirLeitoresConcorrentes(const std::string& nome, Base& base, const std::vector<ChaveCPF>& chaves,
+                               size_t leitores, size_t buscasPorThread, bool comEscritor) {
+    std::atomic<bool> parar(false);
+    std::atomic<size_t> encontrados(0);
+    size_t escritas = 0;
+    std::thread escritor;
+    if (comEscritor) {
+        escritor = std::thread([&]() {
+            // CPFs fora do conjunto carregado (semente diferente), inseridos e removidos em seguida.
+            std::vector<std::string> novos = gerarCPFs(1024, 31337);
+            while (!parar.load()) {
+                const std::string& cpf = novos[escritas % novos.size()];
+                base.inserir(Registro(cpf, "Escritor", "01/01/2000", 'M'));
+                base.remover(cpf);
+                escritas += 2;
+            }
+        });
+    }
+
+    Relogio::time_point inicio = Relogio::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < leitores; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            Registro registro;
+            size_t achados = 0;
+            for (size_t i = 0; i < buscasPorThread; ++i) {
+                achados += base.buscarRegistro(chaves[(i * 7919 + t * 104729) % chaves.size()], registro);
+            }
+            encontrados += achados;
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    double segundos = segundosDesde(inicio);
+    parar = true;
+    if (escritor.joinable()) {
+        escritor.join();
+    }
+
+    reportar(nome, std::to_string(leitores) + (comEscritor ? " leitores + escritor" : " leitores"),
+             leitores * buscasPorThread, segundos);
+    if (comEscritor) {
+        std::cout << "  " << nome << " - escritas durante a medicao: " << escritas << std::endl;
+    }
+    if (encontrados.load() != leitores * buscasPorThread) {
+        std::cout << "  ERRO: " << nome << " nao encontrou todas as chaves." << std::endl;
+    }
+}
+
+// Escalabilidade das leituras com n registros na base.
+void benchmarkConcorrente(size_t n) {
+    const size_t BUSCAS_POR_THREAD = 500000;
+    std::cout << "\n=== Leituras concorrentes em uma base com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 555);
+    std::vector<ChaveCPF> chaves(textos.begin(), textos.end());
+
+    BaseConcorrente concorrente;
+    BaseComMutex comMutex;
+    for (size_t i = 0; i < n; ++i) {
+        Registro registro(textos[i], "Pessoa " + std::to_string(i), "01/01/1990", 'F');
+        concorrente.inserir(registro);
+        comMutex.inserir(registro);
+    }
+    std::vector<std::string>().swap(textos);
+
+    size_t maximo = std::max<size_t>(4, std::thread::hardware_concurrency());
+    for (int comEscritor = 0; comEscritor <= 1; ++comEscritor) {
+        for (size_t leitores = 1; leitores <= maximo; leitores *= 2) {
+            medirLeitoresConcorrentes("Left-Right", concorrente, chaves, leitores, BUSCAS_POR_THREAD, comEscritor != 0);
+            medirLeitoresConcorrentes("Mutex global", comMutex, chaves, leitores, BUSCAS_POR_THREAD, comEscritor != 0);
+        }
+    }
+}
+
+// EDL persistente com n registros. O arquivo é criado no diretório atual e apagado no final.
+void benchmarkArquivo(size_t n) {
+    const std::string CAMINHO = "benchmark_edl.edl";
+    std::cout << "\n=== EDL em arquivo com " << n << " registros ===" << std::endl;
+    std::remove(CAMINHO.c_str());
+    std::vector<std::string> textos = gerarCPFs(n, 8080);
+
+    Relogio::time_point inicio = Relogio::now();
+    {
+        EDLArquivo arquivo(CAMINHO);
+        for (size_t i = 0; i < n; ++i) {
+            arquivo.inserirRegistro(Registro(textos[i], "Pessoa " + std::to_string(i), "01/01/1990", 'F'));
+        }
+    } // Fecha o arquivo (msync + truncamento)
+    reportar("EDL em arquivo", "gravacao", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    EDLArquivo arquivo(CAMINHO);
+    std::cout << "  EDL em arquivo - reabertura: " << segundosDesde(inicio) << " s ("
+              << arquivo.getTamanho() << " registros)" << std::endl;
+
+    // O que um reinício custava antes: reconstruir a EDL em memória registro a registro.
+    inicio = Relogio::now();
+    EDL emMemoria;
+    for (size_t i = 0; i < arquivo.getTamanho(); ++i) {
+        emMemoria.inserirRegistro(arquivo.buscarPorPosicao(static_cast<int>(i)).paraRegistro());
+    }
+    reportar("EDL em memoria", "recarga completa", n, segundosDesde(inicio));
+
+    size_t ativos = 0;
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        ativos += !arquivo.buscarPorPosicao(static_cast<int>((i * 7919) % n)).isDeletado();
+    }
+    reportar("EDL em arquivo", "busca por posicao", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        ativos -= !emMemoria.buscarPorPosicao(static_cast<int>((i * 7919) % n)).isDeletado();
+    }
+    reportar("EDL em memoria", "busca por posicao", n, segundosDesde(inicio));
+
+    ABB indice(TipoBalanceamento::AVL);
+    inicio = Relogio::now();
+    reconstruirIndice(indice, arquivo);
+    reportar("EDL em arquivo", "reconstrucao do indice", n, segundosDesde(inicio));
+    std::cout << "  (diferenca " << ativos << ", indice com " << indice.getTamanho() << " chaves)" << std::endl;
+    std::remove(CAMINHO.c_str());
+}
+
+// Nome sintético com duas partes de sobrenome: ~24 mil combinações distintas,
+// quase todas longas demais para a otimização de strings pequenas.
+std::string gerarNome(size_t i) {
+    static const char* PRIMEIROS[] = {"Alice", "Bruno", "Carla", "Daniel", "Eduarda", "Felipe",
+                                      "Gabriela", "Henrique", "Isabela", "Joao", "Larissa", "Marcos",
+                                      "Natalia", "Otavio", "Paula", "Rafael", "Sofia", "Thiago",
+                                      "Vitoria", "Wagner"};
+    static const char* SOBRENOMES[] = {"Silva", "Santos", "Oliveira", "Souza", "Rodrigues", "Ferreira",
+                                       "Alves", "Pereira", "Lima", "Gomes", "Costa", "Ribeiro",
+                                       "Martins", "Carvalho", "Almeida", "Lopes", "Soares", "Fernandes",
+                                       "Vieira", "Barbosa", "Rocha", "Dias", "Nascimento", "Andrade",
+                                       "Moreira", "Nunes", "Marques", "Machado", "Mendes", "Freitas",
+                                       "Cardoso", "Ramos", "Goncalves", "Santana", "Teixeira"};
+    const size_t P = sizeof(PRIMEIROS) / sizeof(PRIMEIROS[0]);
+    const size_t S = sizeof(SOBRENOMES) / sizeof(SOBRENOMES[0]);
+    return std::string(PRIMEIROS[i % P]) + " " + SOBRENOMES[(i / P) % S] + " " + SOBRENOMES[(i / (P * S)) % S];
+}
+
+// Memória e varredura de uma EDL com n registros nos dois formatos.
+void benchmarkMemoria(size_t n) {
+    std::cout << "\n=== Memoria de uma EDL com " << n << " registros ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 1357);
+    EDL edl;
+    EDLColunar colunar;
+    for (size_t i = 0; i < n; ++i) {
+        Registro registro(textos[i], gerarNome(i), "01/01/1990", i % 2 ? 'F' : 'M');
+        edl.inserirRegistro(registro);
+        colunar.inserirRegistro(registro);
+    }
+    std::vector<std::string>().swap(textos);
+
+    std::cout << "  EDL (vetor de Registro): " << edl.getMemoriaBytes() << " bytes ("
+              << static_cast<double>(edl.getMemoriaBytes()) / n << " bytes/registro)" << std::endl;
+    std::cout << "  EDL colunar: " << colunar.getMemoriaBytes() << " bytes ("
+              << static_cast<double>(colunar.getMemoriaBytes()) / n << " bytes/registro, "
+              << colunar.getNomesDistintos() << " nomes distintos)" << std::endl;
+
+    // Varredura de um campo: na EDL colunar só a coluna de sexo é lida.
+    size_t mulheres = 0;
+    Relogio::time_point inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        mulheres += edl.buscarPorPosicao(static_cast<int>(i)).getSexo() == 'F';
+    }
+    reportar("EDL (vetor de Registro)", "varredura do sexo", n, segundosDesde(inicio));
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        mulheres -= colunar.buscarPorPosicao(static_cast<int>(i)).getSexo() == 'F';
+    }
+    reportar("EDL colunar", "varredura do sexo", n, segundosDesde(inicio));
+    std::cout << "  (diferenca " << mulheres << ")" << std::endl;
+}
+
+// Consultas por faixa de CPFs em um índice com n chaves: cada consulta cobre cerca de
+// 'porConsulta' chaves. A varredura completa (o que era preciso antes) serve de referência.
+void benchmarkIntervalo(size_t n) {
+    const size_t CONSULTAS = 1000;
+    const unsigned long long ESPACO = 100000000000ULL; // 10^11 CPFs possíveis
+    std::cout << "\n=== Consultas por faixa em um indice com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 99);
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        entradas.push_back(EntradaIndice(textos[i], static_cast<int>(i)));
+    }
+    std::vector<std::string>().swap(textos);
+    ABB abb(std::move(entradas), false, TipoBalanceamento::AVL);
+
+    // Largura da faixa para ~100 chaves por consulta (as chaves são uniformes no espaço).
+    unsigned long long largura = ESPACO / std::max<size_t>(1, n) * 100;
+    size_t encontradas = 0;
+    Relogio::time_point inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        unsigned long long base = (q * 7919ULL * 1000003ULL) % (ESPACO - largura);
+        encontradas += abb.buscarIntervalo(ChaveCPF::deValor(base), ChaveCPF::deValor(base + largura - 1)).size();
+    }
+    reportar("Faixa", "consultas", CONSULTAS, segundosDesde(inicio));
+    std::cout << "  Faixa - chaves por consulta: " << encontradas / CONSULTAS << std::endl;
+
+    // Prefixos de 5 dígitos ("ddd.dd"): cada um cobre 1/10^5 do espaço.
+    encontradas = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        std::string prefixo = formatarCPF((q * 7919ULL) % 100000ULL * 1000000ULL).substr(0, 6);
+        encontradas += abb.buscarPrefixo(prefixo).size();
+    }
+    reportar("Prefixo", "consultas", CONSULTAS, segundosDesde(inicio));
+    std::cout << "  Prefixo - chaves por consulta: " << encontradas / CONSULTAS << std::endl;
+
+    // Só a contagem da faixa, com o tamanho das subárvores: O(log n), sem visitar as chaves.
+    encontradas = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        unsigned long long base = (q * 7919ULL * 1000003ULL) % (ESPACO - largura);
+        encontradas += abb.contarIntervalo(ChaveCPF::deValor(base), ChaveCPF::deValor(base + largura - 1));
+    }
+    reportar("Contagem da faixa", "consultas", CONSULTAS, segundosDesde(inicio));
+    std::cout << "  Contagem da faixa - chaves por consulta: " << encontradas / CONSULTAS << std::endl;
+
+    // Páginas de 50 entradas em posições aleatórias da listagem: o custo não depende da página.
+    const size_t POR_PAGINA = 50;
+    size_t paginas = std::max<size_t>(1, n / POR_PAGINA);
+    encontradas = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        encontradas += abb.pagina((q * 7919ULL) % paginas, POR_PAGINA).size();
+    }
+    reportar("Paginacao", "paginas", CONSULTAS, segundosDesde(inicio));
+
+    // Referência: uma consulta por faixa resolvida com um percurso completo.
+    encontradas = 0;
+    ChaveCPF menor = ChaveCPF::deValor(ESPACO / 2);
+    ChaveCPF maior = ChaveCPF::deValor(ESPACO / 2 + largura - 1);
+    inicio = Relogio::now();
+    for (const EntradaIndice& entrada : abb) {
+        if (menor <= entrada.getChave() && entrada.getChave() <= maior) {
+            ++encontradas;
+        }
+    }
+    reportar("Varredura completa", "1 consulta", 1, segundosDesde(inicio));
+    std::cout << "  Varredura completa - chaves: " << encontradas << std::endl;
+}
+
+// EDL ordenada por CPF: versão registro a registro (a original do Requisito 6)
+// contra gerarEDLOrdenada com uma thread e com todas.
+void benchmarkOrdenada(size_t n) {
+    std::cout << "\n=== EDL ordenada com " << n << " registros ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 4242);
+    EDL edl;
+    for (size_t i = 0; i < n; ++i) {
+        edl.inserirRegistro(Registro(textos[i], gerarNome(i), "01/01/1990", 'F'));
+    }
+    std::vector<std::string>().swap(textos);
+    ABB indice(TipoBalanceamento::AVL);
+    reconstruirIndice(indice, edl);
+
+    Relogio::time_point inicio = Relogio::now();
+    EDL sequencial;
+    for (const EntradaIndice& entrada : indice) {
+        const Registro& registro = edl.buscarPorPosicao(entrada.getPosicaoEDL());
+        if (!registro.isDeletado()) {
+            sequencial.inserirRegistro(registro);
+        }
+    }
+    reportar("Registro a registro", "geracao", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    EDL umaThread = gerarEDLOrdenada(indice, edl, 1);
+    reportar("gerarEDLOrdenada (1 thread)", "geracao", n, segundosDesde(inicio));
+
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    inicio = Relogio::now();
+    EDL paralela = gerarEDLOrdenada(indice, edl);
+    reportar("gerarEDLOrdenada (" + std::to_string(threads) + " threads)", "geracao", n, segundosDesde(inicio));
+
+    size_t diferentes = 0;
+    for (size_t i = 0; i < paralela.getTamanho(); ++i) {
+        diferentes += paralela.buscarPorPosicao(static_cast<int>(i)).getCpf() !=
+                      sequencial.buscarPorPosicao(static_cast<int>(i)).getCpf();
+    }
+    std::cout << "  (" << paralela.getTamanho() << " registros, " << diferentes << " diferencas, "
+              << umaThread.getTamanho() << " com uma thread)" << std::endl;
+}
+
+// Partida a frio do índice: reconstruir com n inserções contra recarregar a fotografia.
+void benchmarkFotografia(size_t n) {
+    const std::string CAMINHO = "benchmark_indice.idx";
+    std::cout << "\n=== Fotografia do indice com " << n << " CPFs ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 2024);
+    std::vector<ChaveCPF> chaves(textos.begin(), textos.end());
+    std::vector<std::string>().swap(textos);
+
+    Relogio::time_point inicio = Relogio::now();
+    ABB original(TipoBalanceamento::AVL);
+    for (size_t i = 0; i < n; ++i) {
+        original.inserir(EntradaIndice(chaves[i], static_cast<int>(i)));
+    }
+    reportar("ABB AVL", "reconstrucao por insercoes", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    salvarIndice(original, CAMINHO);
+    reportar("Fotografia", "gravacao", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    ABB recarregada(TipoBalanceamento::AVL);
+    carregarIndice(recarregada, CAMINHO);
+    reportar("Fotografia", "recarga da ABB", n, segundosDesde(inicio));
+
+    inicio = Relogio::now();
+    IndiceMapeado mapeado(CAMINHO);
+    std::cout << "  Fotografia - abertura por mmap: " << segundosDesde(inicio) << " s ("
+              << mapeado.getTamanho() << " entradas)" << std::endl;
+
+    std::vector<ChaveCPF> consultas(chaves.rbegin(), chaves.rend());
+    long long soma = 0;
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        soma += recarregada.buscarPosicao(consultas[i]);
+    }
+    reportar("ABB recarregada", "busca", n, segundosDesde(inicio));
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        soma -= mapeado.buscarPosicao(consultas[i]);
+    }
+    reportar("Fotografia mapeada", "busca", n, segundosDesde(inicio));
+    std::cout << "  (diferenca " << soma << ")" << std::endl;
+    std::remove(CAMINHO.c_str());
+}
+
+// Apaga os arquivos de uma BancoDados e o seu diretório.
+void apagarBase(const std::string& diretorio) {
+    std::remove((diretorio + "/base.wal").c_str());
+    std::remove((diretorio + "/base.chk").c_str());
+    std::remove((diretorio + "/base.chk.tmp").c_str());
+    ::rmdir(diretorio.c_str());
+}
+
+// n inserções duráveis com grupos de tamanhos diferentes: o custo por operação cai
+// à medida que a mesma fdatasync passa a confirmar mais operações.
+void benchmarkDiario(size_t n) {
+    const std::string DIRETORIO = "benchmark_wal";
+    const size_t GRUPOS[] = {1, 8, 64, 512};
+    std::cout << "\n=== Diario de escrita com " << n << " insercoes ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 1313);
+
+    for (size_t grupo : GRUPOS) {
+        apagarBase(DIRETORIO);
+        BancoDados base(DIRETORIO, grupo);
+        Relogio::time_point inicio = Relogio::now();
+        for (size_t i = 0; i < n; ++i) {
+            base.inserir(Registro(textos[i], "Pessoa " + std::to_string(i), "01/01/1990", 'M'));
+        }
+        base.confirmar();
+        double segundos = segundosDesde(inicio);
+        reportar("Grupo de " + std::to_string(grupo), "insercao duravel", n, segundos);
+        std::cout << "  Grupo de " << grupo << " - " << segundos / n * 1e6 << " us por operacao, "
+                  << base.getDiario().getSincronizacoes() << " sincronizacoes" << std::endl;
+    }
+
+    // Recuperação: reabrir reaplicando o diário inteiro, e depois de um checkpoint.
+    Relogio::time_point inicio = Relogio::now();
+    {
+        BancoDados base(DIRETORIO);
+        std::cout << "  Reabertura reaplicando o diario: " << segundosDesde(inicio) << " s ("
+                  << base.getOperacoesReaplicadas() << " operacoes)" << std::endl;
+        inicio = Relogio::now();
+        base.checkpoint();
+        std::cout << "  Checkpoint: " << segundosDesde(inicio) << " s" << std::endl;
+    }
+    inicio = Relogio::now();
+    {
+        BancoDados base(DIRETORIO);
+        std::cout << "  Reabertura a partir do checkpoint: " << segundosDesde(inicio) << " s ("
+                  << base.getIndice().getTamanho() << " chaves)" << std::endl;
+    }
+    apagarBase(DIRETORIO);
+}
+
+// Data "dd/mm/aaaa" sintética, espalhada por 1950-2009 (dia 1 a 28).
+std::string gerarData(size_t i) {
+    char texto[16];
+    std::snprintf(texto, sizeof(texto), "%02u/%02u/%04u", static_cast<unsigned>(i % 28 + 1),
+                  static_cast<unsigned>((i / 28) % 12 + 1), static_cast<unsigned>(1950 + (i / 336) % 60));
+    return texto;
+}
+
+// Consultas por nome e por faixa de datas em uma EDL com n registros: pelos índices
+// secundários (O(log n + k)) e pela varredura da EDL, que era o único caminho antes deles.
+void benchmarkSecundario(size_t n) {
+    const size_t CONSULTAS = 1000;
+    const size_t VARREDURAS = 5;
+    std::cout << "\n=== Indices secundarios sobre uma EDL com " << n << " registros ===" << std::endl;
+    std::vector<std::string> textos = gerarCPFs(n, 2024);
+    EDL edl;
+    for (size_t i = 0; i < n; ++i) {
+        size_t embaralhado = (i * 7919) % n; // Nomes e datas fora da ordem de inserção
+        edl.inserirRegistro(Registro(textos[i], gerarNome(embaralhado), gerarData(embaralhado), i % 2 ? 'F' : 'M'));
+    }
+    std::vector<std::string>().swap(textos);
+
+    IndiceNome indiceNome;
+    IndiceDataNascimento indiceNascimento;
+    Relogio::time_point inicio = Relogio::now();
+    indiceNome.reconstruir(edl);
+    reportar("Indice de nomes", "construcao (carga em lote)", n, segundosDesde(inicio));
+    inicio = Relogio::now();
+    indiceNascimento.reconstruir(edl);
+    reportar("Indice de datas", "construcao (carga em lote)", n, segundosDesde(inicio));
+
+    // Igualdade por nome.
+    size_t encontrados = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        encontrados += indiceNome.buscar(gerarNome(q * 104729)).size();
+    }
+    reportar("Indice de nomes", "consultas", CONSULTAS, segundosDesde(inicio));
+    std::cout << "  Indice de nomes - registros por consulta: " << encontrados / CONSULTAS << std::endl;
+
+    encontrados = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < VARREDURAS; ++q) {
+        std::string nome = gerarNome(q * 104729);
+        for (size_t i = 0; i < edl.getTamanho(); ++i) {
+            const Registro& registro = edl.buscarPorPosicao(static_cast<int>(i));
+            encontrados += !registro.isDeletado() && registro.getNome() == nome;
+        }
+    }
+    reportar("Varredura da EDL (nome)", "consultas", VARREDURAS, segundosDesde(inicio));
+
+    // Faixa de um mês de datas de nascimento (~1/720 dos registros).
+    encontrados = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < CONSULTAS; ++q) {
+        std::string mes = gerarData(q * 28 * 7919).substr(2);
+        encontrados += indiceNascimento.buscarIntervalo("01" + mes, "28" + mes).size();
+    }
+    reportar("Indice de datas", "consultas por mes", CONSULTAS, segundosDesde(inicio));
+    std::cout << "  Indice de datas - registros por consulta: " << encontrados / CONSULTAS << std::endl;
+
+    encontrados = 0;
+    inicio = Relogio::now();
+    for (size_t q = 0; q < VARREDURAS; ++q) {
+        std::string mes = ExtratorDataNascimento::normalizar(gerarData(q * 28 * 7919)).substr(0, 8);
+        for (size_t i = 0; i < edl.getTamanho(); ++i) {
+            const Registro& registro = edl.buscarPorPosicao(static_cast<int>(i));
+            encontrados += !registro.isDeletado() &&
+                ExtratorDataNascimento::chave(registro).compare(0, mes.size(), mes) == 0;
+        }
+    }
+    reportar("Varredura da EDL (data)", "consultas por mes", VARREDURAS, segundosDesde(inicio));
+
+    // Manutenção: remover e reinserir registros nos dois índices secundários.
+    const size_t ALTERACOES = std::min<size_t>(n, 100000);
+    inicio = Relogio::now();
+    for (size_t i = 0; i < ALTERACOES; ++i) {
+        int posicao = static_cast<int>((i * 7919) % n);
+        const Registro& registro = edl.buscarPorPosicao(posicao);
+        indiceNome.remover(registro, posicao);
+        indiceNascimento.remover(registro, posicao);
+        indiceNome.inserir(registro, posicao);
+        indiceNascimento.inserir(registro, posicao);
+    }
+    reportar("Indices secundarios", "remocao + reinsercao", ALTERACOES, segundosDesde(inicio));
+}
+
+// Buscas por CPFs ausentes (o caso comum ao verificar se um CPF novo já existe) e presentes,
+// na ABB AVL sozinha e com um filtro de Bloom na frente, como faz o BancoDados.
+void benchmarkFiltro(size_t n) {
+    std::cout << "\n=== Filtro de Bloom na frente de uma ABB AVL com " << n << " CPFs ===" << std::endl;
+    // 2n CPFs distintos: a primeira metade vai para o índice, a segunda só é consultada.
+    std::vector<std::string> textos = gerarCPFs(2 * n, 4321);
+    std::vector<EntradaIndice> entradas;
+    entradas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        entradas.push_back(EntradaIndice(ChaveCPF(textos[i]), static_cast<int>(i)));
+    }
+    std::vector<ChaveCPF> ausentes(textos.begin() + n, textos.end());
+    std::vector<ChaveCPF> presentes;
+    presentes.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        presentes.push_back(entradas[(i * 7919) % n].getChave());
+    }
+    std::vector<std::string>().swap(textos);
+    ABB abb(std::move(entradas), false, TipoBalanceamento::AVL);
+
+    long long soma = 0; // Evita que o compilador descarte as buscas
+    Relogio::time_point inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        soma += abb.buscarPosicao(ausentes[i]);
+    }
+    double semFiltro = segundosDesde(inicio);
+    reportar("ABB AVL", "busca de ausentes", n, semFiltro);
+    inicio = Relogio::now();
+    for (size_t i = 0; i < n; ++i) {
+        soma += abb.buscarPosicao(presentes[i]);
+    }
+    reportar("ABB AVL", "busca de presentes", n, segundosDesde(inicio));
+
+    const double TAXAS[] = {0.01, 0.001, 0.0001};
+    for (double taxa : TAXAS) {
+        std::string nome = "Filtro " + std::to_string(taxa * 100).substr(0, 4) + "% + ABB AVL";
+        inicio = Relogio::now();
+        FiltroBloom filtro(n, taxa);
+        for (const EntradaIndice& entrada : abb) {
+            filtro.adicionar(entrada.getChave().getValor());
+        }
+        reportar(nome, "construcao do filtro", n, segundosDesde(inicio));
+
+        size_t falsosPositivos = 0;
+        inicio = Relogio::now();
+        for (size_t i = 0; i < n; ++i) {
+            if (filtro.podeConter(ausentes[i].getValor())) {
+                ++falsosPositivos;
+                soma += abb.buscarPosicao(ausentes[i]);
+            } else {
+                soma -= 1;
+            }
+        }
+        double comFiltro = segundosDesde(inicio);
+        reportar(nome, "busca de ausentes", n, comFiltro);
+        inicio = Relogio::now();
+        for (size_t i = 0; i < n; ++i) {
+            soma += filtro.podeConter(presentes[i].getValor()) ? abb.buscarPosicao(presentes[i]) : -1;
+        }
+        reportar(nome, "busca de presentes", n, segundosDesde(inicio));
+        std::cout << "  " << nome << " - " << filtro.getFuncoes() << " funcoes, "
+                  << static_cast<double>(filtro.getBytes()) * 8 / n << " bits por CPF, falsos positivos "
+                  << 100.0 * falsosPositivos / n << "%, ausentes " << semFiltro / comFiltro
+                  << "x mais rapidos" << std::endl;
+    }
+    std::cout << "  (checksum " << soma << ")" << std::endl;
+}
+
+// Lê os tamanhos passados na linha de comando (a partir de argv[2]).
+std::vector<size_t> lerTamanhos(int argc, char* argv[], size_t padrao) {
+    std::vector<size_t> tamanhos;
+    for (int i = 2; i < argc; ++i) {
+        tamanhos.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+    }
+    if (tamanhos.empty()) {
+        tamanhos.push_back(padrao);
+    }
+    return tamanhos;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string modo = argc > 1 ? argv[1] : "indices";
+
+    if (modo == "indices") {
+        // Ex.: ./build/benchmark indices 1000000 10000000 50000000
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkIndices(tamanhos[i]);
+        }
+    } else if (modo == "carga") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkCarga(tamanhos[i]);
+        }
+    } else if (modo == "lote") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkLote(tamanhos[i]);
+        }
+    } else if (modo == "concorrente") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkConcorrente(tamanhos[i]);
+        }
+    } else if (modo == "arquivo") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkArquivo(tamanhos[i]);
+        }
+    } else if (modo == "memoria") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkMemoria(tamanhos[i]);
+        }
+    } else if (modo == "intervalo") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkIntervalo(tamanhos[i]);
+        }
+    } else if (modo == "percurso") {
+        // Ex.: ./build/benchmark percurso 50000000
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkPercurso(tamanhos[i]);
+        }
+    } else if (modo == "ordenada") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkOrdenada(tamanhos[i]);
+        }
+    } else if (modo == "fotografia") {
+        // Ex.: ./build/benchmark fotografia 30000000
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkFotografia(tamanhos[i]);
+        }
+    } else if (modo == "wal") {
+        // Cada confirmação é uma fdatasync: tamanhos pequenos já mostram a diferença.
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 10000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkDiario(tamanhos[i]);
+        }
+    } else if (modo == "secundario") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkSecundario(tamanhos[i]);
+        }
+    } else if (modo == "filtro") {
+        std::vector<size_t> tamanhos = lerTamanhos(argc, argv, 1000000);
+        for (size_t i = 0; i < tamanhos.size(); ++i) {
+            benchmarkFiltro(tamanhos[i]);
+        }
+    } else {
+        std::cout << "Uso: " << argv[0] << " <indices|carga|lote|concorrente|arquivo|memoria|intervalo|percurso|ordenada|fotografia|wal|secundario|filtro> [tamanhos...]" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,55 +1,29 @@
 #include "Registro.h"
 #include "abb/EntradaIndice.h"
-#include "abb/NoABB.h"
 #include "abb/ABB.h"
 #include "EDL.h"
+#include "Indexacao.h"
+#include "BancoDados.h"
+#include "persistencia/IndiceMapeado.h"
+#include <cstdio>     // Para std::remove
 #include <limits>     // Para std::numeric_limits
-#include <functional> // Para std::function (lambdas recursivas)
 #include <iostream>   // Para std::cout, std::cin
+#include <vector>     // Para os resultados das consultas por faixa
 
 // Função auxiliar para limpar o buffer de entrada (se necessário para interação com o usuário)
 void limparBufferEntrada() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
-// Função que implementa o Requisito 6:
+// Função que demonstra o Requisito 6:
 // Cria uma nova Estrutura de Dados Linear (EDL) contendo os Registros
-// ordenados pela chave (CPF), utilizando um percurso em ordem da ABB.
-void gerarEDLOrdenada(const ABB& abbIndices, const EDL& edlOriginal) {
+// ordenados pela chave (CPF), utilizando um percurso em ordem da ABB
+// (gerarEDLOrdenada, em Indexacao.h), e a imprime.
+void imprimirEDLOrdenada(const ABB& abbIndices, const EDL& edlOriginal) {
     std::cout << "\n*** Simulação do requisito 6: Gerando EDL Ordenada por CPF ***" << std::endl;
-    
-    // Cria uma nova instância da EDL para armazenar os registros ordenados.
-    EDL novaEDLOrdenada; 
-
-    // Lambda recursiva que simula o percurso em ordem da ABB.
-    // Para cada nó visitado na ABB, ela busca o Registro correspondente na EDL original
-    // e o insere na 'novaEDLOrdenada' se não estiver marcado como deletado.
-    std::function<void(NoABB*)> popularEDLOrdenada =
-        [&](NoABB* no) {
-        if (no) {
-            // 1. Percorre a subárvore esquerda
-            popularEDLOrdenada(no->esq);
-
-            // 2. Visita o nó atual: recupera o Registro da EDL original e o adiciona à nova EDL.
-            // Verifica se a posição é válida e se o registro não está logicamente deletado.
-            if (no->dado.getPosicaoEDL() != -1 && 
-                static_cast<size_t>(no->dado.getPosicaoEDL()) < edlOriginal.getTamanho()) 
-            {
-                // Usa 'buscarPorPosicao' const para acesso, pois não modificamos o original aqui.
-                const Registro& regNaEDL = edlOriginal.buscarPorPosicao(no->dado.getPosicaoEDL());
-                if (!regNaEDL.isDeletado()) {
-                    novaEDLOrdenada.inserirRegistro(regNaEDL);
-                }
-            }
-
-            // 3. Percorre a subárvore direita
-            popularEDLOrdenada(no->dir);
-        }
-    };
-    
-    // Inicia o percurso da ABB a partir da raiz.
-    // Acesso direto a 'abbIndices.raiz' é permitido devido à declaração 'friend' em ABB.h.
-    popularEDLOrdenada(abbIndices.raiz); 
+
+    // Registros não deletados, na ordem do percurso em ordem da ABB.
+    EDL novaEDLOrdenada = gerarEDLOrdenada(abbIndices, edlOriginal);
 
     // Imprime o conteúdo da nova EDL ordenada.
     novaEDLOrdenada.imprimirTodosRegistros();
@@ -60,7 +34,9 @@ void gerarEDLOrdenada(const ABB& abbIndices, const EDL& edlOriginal) {
 int main() {
     // Cria instâncias da EDL (Arquivo de Registros) e da ABB (Arquivo de Índices).
     EDL arquivoRegistros; // Armazena os objetos Registro completos.
-    ABB arquivoIndices;   // Armazena chaves (CPF) e posições na EDL para busca rápida.
+    // O índice usa balanceamento AVL: as cargas de CPF costumam chegar ordenadas,
+    // o que degeneraria uma ABB simples em uma lista encadeada.
+    ABB arquivoIndices(TipoBalanceamento::AVL); // Armazena chaves (CPF) e posições na EDL para busca rápida.
 
     std::cout << "--- Inserindo Registros na EDL e na ABB de Indices ---" << std::endl;
     
@@ -100,6 +76,9 @@ int main() {
     // Exibe o conteúdo atual da EDL e a estrutura da ABB (em ordem).
     arquivoRegistros.imprimirTodosRegistros();
     arquivoIndices.emOrdem(); // Mostra as chaves e suas posições na EDL, ordenadas por CPF.
+    std::cout << "Indice: " << arquivoIndices.getTamanho() << " chaves, altura "
+              << arquivoIndices.getAltura() << ", profundidade media "
+              << arquivoIndices.getProfundidadeMedia() << std::endl;
 
     // 5. Implementação do Método de Acesso por Chave (CPF)
     std::cout << "\n--- Testando Acesso por Chave (CPF) ---" << std::endl;
@@ -128,6 +107,32 @@ int main() {
     }
     std::cout << "----------------------------------------" << std::endl;
 
+    // Consultas por faixa: só os nós do intervalo são visitados, em ordem de CPF.
+    std::cout << "\n--- Testando Consultas por Faixa de CPF ---" << std::endl;
+    std::vector<int> posicoesFaixa = arquivoIndices.buscarIntervalo("200.000.000-00", "450.000.000-00");
+    std::cout << "CPFs entre 200.000.000-00 e 450.000.000-00: " << posicoesFaixa.size() << std::endl;
+    for (size_t i = 0; i < posicoesFaixa.size(); ++i) {
+        arquivoRegistros.buscarPorPosicao(posicoesFaixa[i]).imprimir();
+    }
+    posicoesFaixa = arquivoIndices.buscarPrefixo("555.5");
+    std::cout << "CPFs com prefixo 555.5: " << posicoesFaixa.size() << std::endl;
+    for (size_t i = 0; i < posicoesFaixa.size(); ++i) {
+        arquivoRegistros.buscarPorPosicao(posicoesFaixa[i]).imprimir();
+    }
+
+    // Estatísticas de ordem: contagens e k-ésimo CPF sem percorrer o índice.
+    std::cout << "CPFs menores que 300.000.000-00: " << arquivoIndices.contarMenores("300.000.000-00") << std::endl;
+    std::cout << "CPFs entre 200.000.000-00 e 450.000.000-00 (so contagem): "
+              << arquivoIndices.contarIntervalo("200.000.000-00", "450.000.000-00") << std::endl;
+    std::cout << "3o menor CPF: " << arquivoIndices.selecionar(2).getChave() << std::endl;
+    std::vector<EntradaIndice> paginaIndice = arquivoIndices.pagina(1, 2); // Segunda página, 2 CPFs por página
+    std::cout << "Pagina 2 da listagem (2 por pagina):";
+    for (size_t i = 0; i < paginaIndice.size(); ++i) {
+        std::cout << " " << paginaIndice[i].getChave();
+    }
+    std::cout << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
     // Testando Remoção de Registros
     std::cout << "\n--- Testando Remoção de Registros ---" << std::endl;
     std::string cpfRemover;
@@ -137,9 +142,9 @@ int main() {
     cpfRemover = "333.333.333-33";
     posRemover = arquivoIndices.buscarPosicao(cpfRemover); // Busca na ABB para obter a posição
     if (posRemover != -1) {
-        // Marca o Registro na EDL como deletado.
-        arquivoRegistros.buscarPorPosicaoParaModificacao(posRemover).marcarComoDeletado();
-        arquivoIndices.remover(cpfRemover); // Remove a EntradaIndice da ABB.
+        // Remove a EntradaIndice da ABB e marca o Registro na EDL como deletado,
+        // liberando sua posição para ser reaproveitada por uma próxima inserção.
+        removerPorCPF(arquivoIndices, arquivoRegistros, cpfRemover);
         std::cout << "Registro com CPF " << cpfRemover << " marcado como deletado na EDL e removido do indice da ABB." << std::endl;
     } else {
         std::cout << "CPF " << cpfRemover << " não encontrado para remoção na ABB." << std::endl;
@@ -149,8 +154,7 @@ int main() {
     cpfRemover = "111.111.111-11";
     posRemover = arquivoIndices.buscarPosicao(cpfRemover);
     if (posRemover != -1) {
-        arquivoRegistros.buscarPorPosicaoParaModificacao(posRemover).marcarComoDeletado();
-        arquivoIndices.remover(cpfRemover);
+        removerPorCPF(arquivoIndices, arquivoRegistros, cpfRemover);
         std::cout << "Registro com CPF " << cpfRemover << " marcado como deletado na EDL e removido do indice da ABB." << std::endl;
     } else {
         std::cout << "CPF " << cpfRemover << " não encontrado para remoção na ABB." << std::endl;
@@ -160,8 +164,7 @@ int main() {
     cpfRemover = "999.999.999-99";
     posRemover = arquivoIndices.buscarPosicao(cpfRemover);
     if (posRemover != -1) {
-        arquivoRegistros.buscarPorPosicaoParaModificacao(posRemover).marcarComoDeletado();
-        arquivoIndices.remover(cpfRemover);
+        removerPorCPF(arquivoIndices, arquivoRegistros, cpfRemover);
         std::cout << "Registro com CPF " << cpfRemover << " marcado como deletado na EDL e removido do indice da ABB." << std::endl;
     } else {
         std::cout << "CPF " << cpfRemover << " não encontrado para remoção na ABB (provavelmente já removido ou nunca inserido)." << std::endl;
@@ -187,7 +190,104 @@ int main() {
     std::cout << "-----------------------------------------" << std::endl;
 
     // Chama a função para gerar e imprimir a EDL ordenada.
-    gerarEDLOrdenada(arquivoIndices, arquivoRegistros);
+    imprimirEDLOrdenada(arquivoIndices, arquivoRegistros);
+
+    // Reconstrução do índice a partir da EDL (ex.: recarga noturna).
+    // A carga em lote produz uma árvore perfeitamente balanceada em tempo linear após a ordenação.
+    // O registro duplicado de Carlos (posição 6) não está deletado e volta ao índice,
+    // pois o original (posição 1) foi deletado.
+    std::cout << "\n--- Reconstruindo o indice a partir da EDL ---" << std::endl;
+    reconstruirIndice(arquivoIndices, arquivoRegistros);
+    arquivoIndices.emOrdem();
+    std::cout << "Indice: " << arquivoIndices.getTamanho() << " chaves, altura "
+              << arquivoIndices.getAltura() << std::endl;
+
+    // O mesmo índice em uma Árvore B+: a carga em lote monta as folhas encadeadas de baixo
+    // para cima, e as consultas usam as mesmas funções de Indexacao.
+    std::cout << "\n--- Indice alternativo em Arvore B+ ---" << std::endl;
+    ArvoreBMais indiceBMais;
+    reconstruirIndice(indiceBMais, arquivoRegistros);
+    indiceBMais.emOrdem();
+    std::cout << "Arvore B+: " << indiceBMais.getTamanho() << " chaves, altura "
+              << indiceBMais.getAltura() << std::endl;
+    std::vector<ChaveCPF> cpfsConsulta;
+    cpfsConsulta.push_back(ChaveCPF("333.333.333-33"));
+    cpfsConsulta.push_back(ChaveCPF("999.999.999-99"));
+    std::vector<int> posicoesConsulta;
+    std::vector<const Registro*> registrosConsulta;
+    buscarRegistrosEmLote(indiceBMais, arquivoRegistros, cpfsConsulta, posicoesConsulta, registrosConsulta);
+    for (size_t i = 0; i < cpfsConsulta.size(); ++i) {
+        std::cout << "CPF " << cpfsConsulta[i] << " na Arvore B+: posicao " << posicoesConsulta[i] << std::endl;
+    }
+
+    // Reaproveitamento de posições e compactação da EDL.
+    // A nova inserção ocupa a menor posição livre (a de Alice); a compactação então move
+    // os últimos registros para os buracos restantes, corrigindo as posições no índice.
+    std::cout << "\n--- Reaproveitando posicoes livres e compactando a EDL ---" << std::endl;
+    Registro r7("666.666.666-66", "Fernanda Lima", "06/06/1995", 'F');
+    int pos7 = arquivoRegistros.inserirRegistro(r7);
+    arquivoIndices.inserir(EntradaIndice(r7.getCpf(), pos7));
+    std::cout << "Registro com CPF " << r7.getCpf() << " inserido na posicao " << pos7
+              << " (posicoes livres restantes: " << arquivoRegistros.getPosicoesLivres() << ")" << std::endl;
+    int passos = 0;
+    while (compactarEDL(arquivoRegistros, arquivoIndices, 1)) { // Um passo por vez, como em um laço de serviço
+        ++passos;
+    }
+    std::cout << "Compactacao concluida em " << passos + 1 << " passo(s)." << std::endl;
+    arquivoRegistros.imprimirTodosRegistros();
+    arquivoIndices.emOrdem();
+
+    // Fotografia do índice: gravada em disco e recarregada sem reinserir chave por chave.
+    std::cout << "\n--- Fotografia do indice em disco ---" << std::endl;
+    const std::string caminhoFotografia = "indice_demo.idx";
+    salvarIndice(arquivoIndices, caminhoFotografia);
+    ABB indiceRecarregado(TipoBalanceamento::AVL);
+    carregarIndice(indiceRecarregado, caminhoFotografia);
+    indiceRecarregado.emOrdem();
+    {
+        IndiceMapeado indiceMapeado(caminhoFotografia); // Consultas direto no arquivo, sem montar a ABB
+        std::cout << "CPF 666.666.666-66 na fotografia mapeada: posicao "
+                  << indiceMapeado.buscarPosicao(ChaveCPF("666.666.666-66")) << std::endl;
+    }
+    std::remove(caminhoFotografia.c_str());
+
+    // Base durável: as operações passam pelo diário de escrita antes de alterar EDL e ABB.
+    std::cout << "\n--- Base duravel (diario de escrita + checkpoint) ---" << std::endl;
+    const std::string diretorioBase = "base_demo";
+    {
+        BancoDados base(diretorioBase);
+        base.inserir(Registro("777.777.777-77", "Gustavo Reis", "07/07/1996", 'M'));
+        base.inserir(Registro("888.888.888-88", "Helena Prado", "08/08/1997", 'F'));
+        base.remover(ChaveCPF("777.777.777-77"));
+        std::cout << "3 operacoes gravadas no diario (sem checkpoint)." << std::endl;
+    } // Fecha a base como se o programa tivesse parado aqui
+    {
+        BancoDados base(diretorioBase);
+        std::cout << "Base reaberta: " << base.getOperacoesReaplicadas() << " operacoes reaplicadas, "
+                  << base.getIndice().getTamanho() << " CPF(s) no indice." << std::endl;
+        base.checkpoint();
+    }
+    {
+        BancoDados base(diretorioBase);
+        std::cout << "Apos o checkpoint: " << base.getOperacoesReaplicadas() << " operacoes reaplicadas, "
+                  << base.getIndice().getTamanho() << " CPF(s) no indice." << std::endl;
+        base.getIndice().emOrdem();
+
+        // Índices secundários: consultas por nome e por data sem percorrer a EDL.
+        base.inserir(Registro("999.999.999-99", "Helena Prado", "15/03/1990", 'F'));
+        base.inserir(Registro("101.010.101-01", "Igor Matos", "20/12/1997", 'M'));
+        std::cout << "Registros com o nome 'Helena Prado':" << std::endl;
+        for (int posicao : base.buscarPorNome("Helena Prado")) {
+            base.getRegistros().buscarPorPosicao(posicao).imprimir();
+        }
+        std::cout << "Nascidos entre 01/01/1997 e 31/12/1997:" << std::endl;
+        for (int posicao : base.buscarPorNascimentoEntre("01/01/1997", "31/12/1997")) {
+            base.getRegistros().buscarPorPosicao(posicao).imprimir();
+        }
+    }
+    std::remove((diretorioBase + "/base.wal").c_str());
+    std::remove((diretorioBase + "/base.chk").c_str());
+    std::remove(diretorioBase.c_str());
 
     std::cout << "\nFim do programa principal." << std::endl;
     return 0;
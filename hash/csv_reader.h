@@ -0,0 +1,164 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Leitor de CSV em fluxo, sem copias: o arquivo e lido em blocos grandes para um unico
+// buffer, e cada registro e devolvido como string_views que apontam para dentro dele.
+// Nenhuma string e criada por linha ou por campo; quem quiser guardar um campo copia so
+// o que precisa (a HashTable copia a chave para o pool apenas quando ela e inserida).
+//
+// Campos entre aspas seguem o RFC 4180: podem conter o separador, quebras de linha e
+// aspas escritas em dobro (""), que sao desfeitas no proprio buffer. Um '\r' antes da
+// quebra de linha (arquivos do Windows) e descartado.
+//
+// Tambem le um trecho que ja esta na memoria (ex.: parte de um arquivo mapeado com mmap);
+// nesse caso os campos entre aspas sao desfeitos no proprio trecho, que deve ser gravavel.
+//
+// Os campos valem ate a proxima chamada de next(), que pode mover ou aumentar o buffer.
+class CsvReader {
+private:
+    static const size_t DEFAULT_BUFFER = 4 << 20; // 4 MB
+
+    FILE* file;             // nullptr ao ler um trecho da memoria
+    std::vector<char> buffer;
+    char* data;             // buffer.data(), ou o trecho da memoria
+    size_t begin;           // inicio do proximo registro no buffer
+    size_t end;             // fim dos dados lidos
+    bool eof;
+    char delimiter;
+
+    // Traz mais dados do arquivo. O registro incompleto vai para o inicio do buffer, que
+    // dobra de tamanho se o registro sozinho ja o ocupar inteiro.
+    void refill() {
+        if (begin > 0) {
+            memmove(data, data + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+            data = buffer.data();
+        }
+        size_t requested = buffer.size() - end;
+        size_t lidos = fread(data + end, 1, requested, file);
+        end += lidos;
+        if (lidos < requested) eof = true;
+    }
+
+    // Procura o fim do registro que comeca em 'begin' (a quebra de linha fora de aspas).
+    // Retorna false se o registro ainda nao esta inteiro no buffer.
+    bool findRecordEnd(size_t& recordEnd, bool& quoted) const {
+        const char* start = data + begin;
+        const char* limit = data + end;
+        const char* newline = static_cast<const char*>(memchr(start, '\n', limit - start));
+        const char* lineEnd = newline != nullptr ? newline : limit;
+        quoted = memchr(start, '"', lineEnd - start) != nullptr;
+        if (!quoted) {
+            if (newline == nullptr) return false;
+            recordEnd = newline - data;
+            return true;
+        }
+        // Ha aspas: a quebra de linha so encerra o registro fora de um campo entre aspas.
+        bool inQuotes = false;
+        for (const char* p = start; p < limit; ++p) {
+            if (*p == '"') {
+                inQuotes = !inQuotes;
+            } else if (*p == '\n' && !inQuotes) {
+                recordEnd = p - data;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Divide um registro sem aspas: cada campo e o trecho entre dois separadores.
+    void splitPlain(const char* p, const char* limit, std::vector<std::string_view>& fields) const {
+        while (true) {
+            const char* d = static_cast<const char*>(memchr(p, delimiter, limit - p));
+            if (d == nullptr) {
+                fields.emplace_back(p, limit - p);
+                return;
+            }
+            fields.emplace_back(p, d - p);
+            p = d + 1;
+        }
+    }
+
+    // Divide um registro com aspas, reescrevendo cada campo no lugar sem as aspas
+    // (o texto sem aspas nunca e maior que o original).
+    void splitQuoted(char* p, char* limit, std::vector<std::string_view>& fields) const {
+        while (true) {
+            char* start = p;
+            char* out = p;
+            if (p < limit && *p == '"') {
+                ++p;
+                while (p < limit) {
+                    if (*p != '"') {
+                        *out++ = *p++;
+                    } else if (p + 1 < limit && p[1] == '"') {
+                        *out++ = '"';
+                        p += 2;
+                    } else {
+                        ++p; // aspas de fechamento
+                        break;
+                    }
+                }
+            }
+            while (p < limit && *p != delimiter) *out++ = *p++;
+            fields.emplace_back(start, out - start);
+            if (p >= limit) return;
+            ++p; // separador
+        }
+    }
+
+public:
+    explicit CsvReader(const std::string& path, char delimiter = ',', size_t bufferSize = DEFAULT_BUFFER)
+        : file(fopen(path.c_str(), "rb")), buffer(bufferSize > 0 ? bufferSize : 1), data(buffer.data()),
+          begin(0), end(0), eof(false), delimiter(delimiter) {
+        if (file == nullptr) throw std::runtime_error("CsvReader: nao foi possivel abrir " + path);
+    }
+
+    // Le os registros de [inicio, fim), sem copiar o trecho.
+    CsvReader(char* inicio, char* fim, char delimiter = ',')
+        : file(nullptr), data(inicio), begin(0), end(fim - inicio), eof(true), delimiter(delimiter) {}
+
+    ~CsvReader() {
+        if (file != nullptr) fclose(file);
+    }
+
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+
+    // Le o proximo registro em 'fields'. Retorna false no fim do arquivo.
+    bool next(std::vector<std::string_view>& fields) {
+        fields.clear();
+        size_t recordEnd;
+        bool quoted;
+        while (!findRecordEnd(recordEnd, quoted)) {
+            if (eof) {
+                if (begin == end) return false;
+                recordEnd = end; // ultimo registro, sem quebra de linha no final
+                break;
+            }
+            refill();
+        }
+        char* start = data + begin;
+        char* limit = data + recordEnd;
+        begin = recordEnd < end ? recordEnd + 1 : end;
+        if (limit > start && limit[-1] == '\r') --limit;
+        if (quoted) {
+            splitQuoted(start, limit, fields);
+        } else {
+            splitPlain(start, limit, fields);
+        }
+        return true;
+    }
+};
+
+#endif // CSV_READER_H
@@ -0,0 +1,111 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Escritor de CSV com buffer proprio (par do CsvReader). Campos com o separador, aspas
+// ou quebras de linha sao escritos entre aspas, com as aspas internas em dobro, entao o
+// CsvReader le de volta exatamente os mesmos campos. O caminho "-" escreve na saida padrao.
+class CsvWriter {
+private:
+    static const size_t DEFAULT_BUFFER = 1 << 20; // 1 MB
+
+    FILE* file;
+    bool ownsFile;          // false para a saida padrao
+    std::vector<char> buffer;
+    size_t used;
+    char delimiter;
+
+    void flushBuffer() {
+        if (used > 0 && fwrite(buffer.data(), 1, used, file) != used) {
+            throw std::runtime_error("CsvWriter: erro de escrita");
+        }
+        used = 0;
+    }
+
+    void append(const char* texto, size_t tamanho) {
+        if (used + tamanho > buffer.size()) {
+            flushBuffer();
+            if (tamanho > buffer.size()) {
+                if (fwrite(texto, 1, tamanho, file) != tamanho) throw std::runtime_error("CsvWriter: erro de escrita");
+                return;
+            }
+        }
+        memcpy(buffer.data() + used, texto, tamanho);
+        used += tamanho;
+    }
+
+    void append(char c) {
+        if (used == buffer.size()) flushBuffer();
+        buffer[used++] = c;
+    }
+
+    void writeField(std::string_view field) {
+        bool precisaAspas = false;
+        for (char c : field) {
+            if (c == delimiter || c == '"' || c == '\n' || c == '\r') {
+                precisaAspas = true;
+                break;
+            }
+        }
+        if (!precisaAspas) {
+            append(field.data(), field.size());
+            return;
+        }
+        append('"');
+        for (char c : field) {
+            if (c == '"') append('"');
+            append(c);
+        }
+        append('"');
+    }
+
+public:
+    explicit CsvWriter(const std::string& path, char delimiter = ',', size_t bufferSize = DEFAULT_BUFFER)
+        : file(path == "-" ? stdout : fopen(path.c_str(), "wb")), ownsFile(path != "-"),
+          buffer(bufferSize > 0 ? bufferSize : 1), used(0), delimiter(delimiter) {
+        if (file == nullptr) throw std::runtime_error("CsvWriter: nao foi possivel criar " + path);
+    }
+
+    // Fecha o arquivo. Erros de escrita so sao detectados por close(); o destrutor os ignora.
+    ~CsvWriter() {
+        try {
+            close();
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    void writeRecord(const std::vector<std::string_view>& fields) {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (i > 0) append(delimiter);
+            writeField(fields[i]);
+        }
+        append('\n');
+    }
+
+    void writeRecord(std::string_view key, std::string_view value) {
+        writeField(key);
+        append(delimiter);
+        writeField(value);
+        append('\n');
+    }
+
+    void close() {
+        if (file == nullptr) return;
+        bool erro = used > 0 && fwrite(buffer.data(), 1, used, file) != used;
+        used = 0;
+        erro = (ownsFile ? fclose(file) != 0 : fflush(file) != 0) || erro;
+        file = nullptr;
+        if (erro) throw std::runtime_error("CsvWriter: erro ao fechar o arquivo");
+    }
+};
+
+#endif // CSV_WRITER_H
@@ -0,0 +1,184 @@
+#ifndef EXTERNAL_DEDUP_H
+#define EXTERNAL_DEDUP_H
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_reader.h"
+#include "csv_writer.h"
+#include "hash_table.h"
+
+// Resumo de uma eliminacao de duplicatas fora da memoria (ver eliminateDuplicateExternal).
+struct ExternalDedupStats {
+    size_t rows;            // registros lidos da entrada (sem o cabecalho)
+    size_t uniqueKeys;      // registros escritos na saida
+    size_t spilledRows;     // registros gravados em particoes no disco, somando todos os niveis
+    size_t partitionFiles;  // arquivos de particao criados
+    size_t maxDepth;        // maior nivel de particionamento usado (0: tudo coube na memoria)
+};
+
+// Diretorio temporario (em $TMPDIR, ou /tmp) para as particoes. O destrutor apaga os
+// arquivos que ainda existirem e o diretorio, inclusive quando uma excecao interrompe
+// o processamento.
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::string& prefixo) : proximo(0) {
+        const char* base = getenv("TMPDIR");
+        std::string modelo = std::string(base != nullptr && *base != '\0' ? base : "/tmp") + "/" + prefixo + "XXXXXX";
+        std::vector<char> caminho(modelo.begin(), modelo.end());
+        caminho.push_back('\0');
+        if (mkdtemp(caminho.data()) == nullptr) {
+            throw std::runtime_error("TempDirectory: nao foi possivel criar " + modelo);
+        }
+        path = caminho.data();
+    }
+
+    ~TempDirectory() {
+        for (const std::string& arquivo : arquivos) std::remove(arquivo.c_str());
+        rmdir(path.c_str());
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    // Nome para um novo arquivo dentro do diretorio
+    std::string newFile() {
+        arquivos.push_back(path + "/particao_" + std::to_string(proximo++) + ".csv");
+        return arquivos.back();
+    }
+
+    // Apaga um arquivo criado por newFile
+    void removeFile(const std::string& arquivo) {
+        std::remove(arquivo.c_str());
+        for (size_t i = 0; i < arquivos.size(); ++i) {
+            if (arquivos[i] == arquivo) {
+                arquivos[i] = arquivos.back();
+                arquivos.pop_back();
+                break;
+            }
+        }
+    }
+
+    const std::string& getPath() const { return path; }
+
+private:
+    std::string path;
+    std::vector<std::string> arquivos;
+    size_t proximo;
+};
+
+// Elimina duplicatas com a memoria limitada a 'memoryBudget' bytes (a HashTable: posicoes
+// e pool). Cada nivel le um fluxo de registros:
+//  * enquanto a tabela cabe no orcamento, chaves novas entram nela e sao escritas na saida;
+//  * depois que ela enche, chaves que ja estao nela sao descartadas e as demais vao para
+//    uma de FANOUT particoes no disco, escolhida pelo hash da chave;
+//  * no fim do fluxo a tabela e liberada e cada particao e processada da mesma forma, com
+//    o proximo nivel (outra funcao de particionamento). Todas as ocorrencias de uma chave
+//    caem na mesma particao, entao cada particao e deduplicada de forma independente.
+template <typename Hash>
+class ExternalDeduplicator {
+public:
+    ExternalDeduplicator(size_t memoryBudget, CsvWriter& output, Hash hash)
+        : budget(memoryBudget), hasher(hash), output(output), temp("dedup_externa_") {
+        stats.rows = stats.uniqueKeys = stats.spilledRows = stats.partitionFiles = stats.maxDepth = 0;
+    }
+
+    void process(CsvReader& reader, size_t depth) {
+        if (depth > stats.maxDepth) stats.maxDepth = depth;
+        HashTable<Hash> table(0, hasher);
+        std::vector<std::unique_ptr<CsvWriter>> partitions(FANOUT);
+        std::vector<std::string> paths(FANOUT);
+        std::vector<std::string_view> fields;
+        while (reader.next(fields)) {
+            if (depth == 0) ++stats.rows;
+            std::string_view key = fields[0];
+            std::string_view value = fields.size() > 1 ? fields[1] : std::string_view();
+            // No ultimo nivel tudo fica na memoria: so chegaria aqui com bilhoes de chaves
+            // distintas que coincidem em todas as funcoes de particionamento.
+            if (depth >= MAX_DEPTH || table.getMemoryBytes() < budget) {
+                if (table.insert(key, value)) {
+                    output.writeRecord(key, value);
+                    ++stats.uniqueKeys;
+                }
+            } else if (!table.contains(key)) {
+                size_t p = partitionOf(key, depth);
+                if (!partitions[p]) {
+                    paths[p] = temp.newFile();
+                    partitions[p].reset(new CsvWriter(paths[p], ',', PARTITION_BUFFER));
+                    ++stats.partitionFiles;
+                }
+                partitions[p]->writeRecord(key, value);
+                ++stats.spilledRows;
+            }
+        }
+        table = HashTable<Hash>(0, hasher); // libera a memoria antes do proximo nivel
+
+        for (size_t p = 0; p < FANOUT; ++p) {
+            if (!partitions[p]) continue;
+            partitions[p]->close();
+            partitions[p].reset();
+            {
+                CsvReader particao(paths[p]);
+                process(particao, depth + 1);
+            }
+            temp.removeFile(paths[p]);
+        }
+    }
+
+    const ExternalDedupStats& getStats() const { return stats; }
+
+private:
+    static const size_t FANOUT = 16;
+    static const size_t MAX_DEPTH = 6;
+    static const size_t PARTITION_BUFFER = 64 << 10; // 64 KB por particao aberta
+
+    size_t budget;
+    Hash hasher;
+    CsvWriter& output;
+    TempDirectory temp;
+    ExternalDedupStats stats;
+
+    // Particao da chave no nivel 'depth'. O hash e misturado com o nivel, para que as
+    // chaves de uma particao se espalhem de novo no nivel seguinte.
+    size_t partitionOf(std::string_view key, size_t depth) const {
+        return mixBits(hasher(key) + (depth + 1) * 0x9e3779b97f4a7c15ULL) % FANOUT;
+    }
+};
+
+// Elimina as duplicatas do CSV 'inputPath' (chave na 1a coluna, valor na 2a) usando no
+// maximo cerca de 'memoryMb' MB para a tabela, como o tamanho_buffer_mb da ordenacao
+// externa, e escreve o CSV sem duplicatas em 'outputPath' ("-": saida padrao) a medida
+// que as chaves sao encontradas, sem imprimir pela HashTable.
+// Enquanto nada vai para o disco, a saida tem a ordem da primeira ocorrencia, como
+// eliminateDuplicate. Se houver particoes, as chaves delas vem depois, particao por particao
+// (dentro de cada uma, na ordem da primeira ocorrencia).
+// Fora do orcamento ficam os buffers de leitura (4 MB) e de escrita (1 MB, mais 64 KB por
+// particao aberta), e o crescimento da tabela pode passar do limite por uma duplicacao.
+template <typename Hash = StringHash>
+ExternalDedupStats eliminateDuplicateExternal(const std::string& inputPath, const std::string& outputPath,
+                                              size_t memoryMb, Hash hash = Hash()) {
+    if (memoryMb == 0) throw std::invalid_argument("eliminateDuplicateExternal: a memoria deve ser maior que zero.");
+    CsvReader reader(inputPath);
+    CsvWriter output(outputPath);
+    std::vector<std::string_view> fields;
+    if (reader.next(fields)) { // copia o cabecalho (as duas colunas usadas)
+        if (fields.size() > 1) {
+            output.writeRecord(fields[0], fields[1]);
+        } else {
+            output.writeRecord(fields);
+        }
+    }
+    ExternalDeduplicator<Hash> deduplicator(memoryMb * 1024 * 1024, output, hash);
+    deduplicator.process(reader, 0);
+    output.close();
+    return deduplicator.getStats();
+}
+
+#endif // EXTERNAL_DEDUP_H
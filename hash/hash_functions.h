@@ -0,0 +1,124 @@
+#ifndef HASH_FUNCTIONS_H
+#define HASH_FUNCTIONS_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Funcoes de hash para a HashTable, escolhidas como parametro do template
+// (HashTable<FibonacciHash>, HashTable<StringHash>...). Como o tipo e conhecido na
+// compilacao, a chamada e expandida no lugar, sem passar por std::function.
+//
+// Todas devolvem 64 bits bem misturados, e a tabela usa os bits ALTOS para escolher a
+// posicao (como no hashing de Fibonacci) e os baixos como etiqueta de comparacao.
+
+// Finalizador do MurmurHash3: espalha cada bit da entrada por todos os bits da saida.
+inline uint64_t mixBits(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Hash de texto no estilo do wyhash: le a chave 8 bytes por vez e combina cada par de
+// palavras com uma multiplicacao de 64 x 64 -> 128 bits, cujas metades sao somadas por
+// xor. Serve para qualquer chave (nomes, ids com letras...).
+struct StringHash {
+    uint64_t operator()(std::string_view key) const {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(key.data());
+        size_t len = key.size();
+        uint64_t seed = P0 ^ mum(len ^ P1, P2);
+        uint64_t a, b;
+        if (len <= 16) {
+            if (len >= 8) {
+                a = read64(p);
+                b = read64(p + len - 8);
+            } else if (len >= 4) {
+                a = read32(p);
+                b = read32(p + len - 4);
+            } else if (len > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t restante = len;
+            while (restante > 16) {
+                seed = mum(read64(p) ^ P1, read64(p + 8) ^ seed);
+                p += 16;
+                restante -= 16;
+            }
+            a = read64(p + restante - 16);
+            b = read64(p + restante - 8);
+        }
+        return mum(P1 ^ len, mum(a ^ P1, b ^ seed));
+    }
+
+private:
+    static const uint64_t P0 = 0xa0761d6478bd642fULL;
+    static const uint64_t P1 = 0xe7037ed1a0b428dbULL;
+    static const uint64_t P2 = 0x8ebc6af09c88c6e3ULL;
+
+    static uint64_t mum(uint64_t a, uint64_t b) {
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+    }
+    static uint64_t read64(const unsigned char* p) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    static uint64_t read32(const unsigned char* p) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+};
+
+// Hashing multiplicativo (de Fibonacci) para chaves numericas, como CPFs e ids:
+// o valor e multiplicado por 2^64 / phi, e os bits altos do produto (os que a tabela usa)
+// dependem de todos os digitos. Os separadores '.', '-' e '/' sao ignorados (um CPF
+// formatado tem o mesmo hash que os seus digitos). Diferente de hashDivisao (stoull),
+// nao lanca excecao: chaves com outros caracteres, vazias ou com mais de 19 digitos
+// usam o StringHash.
+struct FibonacciHash {
+    uint64_t operator()(std::string_view key) const {
+        uint64_t valor = 0;
+        size_t digitos = 0;
+        for (char c : key) {
+            if (c >= '0' && c <= '9') {
+                valor = valor * 10 + static_cast<uint64_t>(c - '0');
+                ++digitos;
+            } else if (c != '.' && c != '-' && c != '/') {
+                return StringHash()(key);
+            }
+        }
+        if (digitos == 0 || digitos > 19) {
+            return StringHash()(key);
+        }
+        // O numero de digitos entra no valor para que "0012" e "12" nao colidam.
+        return (valor ^ (static_cast<uint64_t>(digitos) << 59)) * 11400714819323198485ULL;
+    }
+};
+
+// Adaptador para funcoes de hash comuns, como hashDivisao: mantem a interface antiga
+// (std::function sobre std::string), ao custo de uma copia da chave e de uma chamada
+// indireta por operacao. A saida e misturada, porque essas funcoes costumam devolver
+// a propria chave.
+struct FunctionHash {
+    std::function<size_t(const std::string&)> func;
+
+    FunctionHash() {}
+    FunctionHash(std::function<size_t(const std::string&)> func) : func(func) {}
+
+    uint64_t operator()(std::string_view key) const {
+        return mixBits(func(std::string(key)));
+    }
+};
+
+#endif // HASH_FUNCTIONS_H
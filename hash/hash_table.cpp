@@ -4,140 +4,547 @@
 #include <fstream>
 #include <sstream>
 #include <functional>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include "csv_reader.h"
+#include "external_dedup.h"
+#include "hash_table.h"
+#include "parallel_dedup.h"
 using namespace std;
 
-// Estrutura de um no encadeado
-class Node {
-public:
-    string key;       // campo chave (por exemplo: cpf ou id)
-    string value;     // campo valor (por exemplo: nome)
-    Node* next;
+// Funcao de dispersao (hash) baseada em divisao
+size_t hashDivisao(const string& key) {
+    return stoull(key); // assume que a chave e numerica
+}
+
+// Funao que elimina duplicatas de um arquivo CSV
+// Os campos chegam como string_views do CsvReader: a chave e o valor so sao copiados
+// (para o pool da tabela) quando a chave e nova.
+template <typename Hash>
+HashTable<Hash> eliminateDuplicate(const string& dataset_path, Hash dispersionFunc = Hash()) {
+    HashTable<Hash> table_hash(120, dispersionFunc); // tamanho inicial: a tabela cresce com a carga
+    CsvReader reader(dataset_path);
+    vector<string_view> fields;
+
+    reader.next(fields); // pula o cabecalho
+
+    while (reader.next(fields)) {
+        string_view value = fields.size() > 1 ? fields[1] : string_view();
+        table_hash.insert(fields[0], value); // so insere se nao for duplicado
+    }
+
+    return table_hash;
+}
+
+// Versao original, com getline e um stringstream por linha (uma string nova por linha
+// e por campo). Mantida como referencia para o benchmark de leitura.
+template <typename Hash>
+HashTable<Hash> eliminateDuplicateGetline(const string& dataset_path, Hash dispersionFunc = Hash()) {
+    HashTable<Hash> table_hash(120, dispersionFunc);
+    ifstream file(dataset_path);
+    string line;
+
+    getline(file, line); // pula o cabecalho
+
+    while (getline(file, line)) {
+        stringstream ss(line);
+        string key, value;
+        getline(ss, key, ',');
+        getline(ss, value, ',');
+
+        table_hash.insert(key, value);
+    }
+
+    return table_hash;
+}
+
+// Segundos decorridos desde 'inicio'
+double secondsSince(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+// Gera n chaves numericas de 11 digitos, distintas e fora de ordem.
+// i -> (i * A + semente) mod 10^11 e uma bijecao porque A nao e divisivel por 2 nem por 5.
+vector<string> generateKeys(size_t n, unsigned long long semente) {
+    const unsigned long long MODULO = 100000000000ULL;
+    const unsigned long long A = 48271ULL * 1000003ULL;
+    vector<string> keys;
+    keys.reserve(n);
+    char texto[16];
+    for (size_t i = 0; i < n; ++i) {
+        snprintf(texto, sizeof(texto), "%011llu", (static_cast<unsigned long long>(i) * A + semente) % MODULO);
+        keys.push_back(texto);
+    }
+    return keys;
+}
+
+// Imprime uma linha do benchmark em milhoes de operacoes por segundo
+void report(const string& tabela, const string& operacao, size_t n, double segundos) {
+    cout << "  " << tabela << " - " << operacao << ": " << segundos << " s ("
+         << n / segundos / 1e6 << " Mops/s)" << endl;
+}
+
+// Mede as operacoes da tabela: insercao de chaves novas, insercao de duplicatas,
+// buscas com e sem sucesso e remocao de metade das chaves. As buscas usam as chaves
+// em outra ordem ('lookups'), para nao visitar os pares na ordem em que foram gravados.
+template <typename Table>
+void benchmarkTable(const string& nome, Table& table, const vector<string>& keys,
+                    const vector<string>& lookups, const vector<string>& misses) {
+    const string value = "Nome";
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (const string& key : keys) table.insert(key, value);
+    report(nome, "insercao", keys.size(), secondsSince(inicio));
+
+    inicio = chrono::steady_clock::now();
+    for (const string& key : lookups) table.insert(key, value);
+    report(nome, "insercao de duplicatas", keys.size(), secondsSince(inicio));
+
+    size_t encontradas = 0;
+    inicio = chrono::steady_clock::now();
+    for (const string& key : lookups) encontradas += !table.search(key).empty();
+    report(nome, "busca com sucesso", keys.size(), secondsSince(inicio));
+
+    inicio = chrono::steady_clock::now();
+    for (const string& key : misses) encontradas += !table.search(key).empty();
+    report(nome, "busca sem sucesso", misses.size(), secondsSince(inicio));
+
+    inicio = chrono::steady_clock::now();
+    for (size_t i = 0; i < lookups.size(); i += 2) encontradas -= table.remove(lookups[i]);
+    report(nome, "remocao", (keys.size() + 1) / 2, secondsSince(inicio));
+    cout << "  (" << encontradas << " chaves restantes)" << endl;
+}
 
-    Node(string k, string v) : key(k), value(v), next(nullptr) {}
+// Mede cada chamada de 'inserir' para todas as chaves e imprime a mediana,
+// o percentil 99,99 e a pior latencia.
+template <typename Insert>
+void measureLatency(const string& nome, const vector<string>& keys, Insert inserir) {
+    vector<double> latencias;
+    latencias.reserve(keys.size());
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (const string& key : keys) {
+        chrono::steady_clock::time_point antes = chrono::steady_clock::now();
+        inserir(key);
+        latencias.push_back(secondsSince(antes));
+    }
+    report(nome, "insercao", keys.size(), secondsSince(inicio));
+    sort(latencias.begin(), latencias.end());
+    cout << "  " << nome << " - latencia: mediana " << latencias[latencias.size() / 2] * 1e6
+         << " us, p99,99 " << latencias[latencias.size() * 9999 / 10000] * 1e6
+         << " us, maxima " << latencias.back() * 1e6 << " us" << endl;
+}
+
+// Insere as chaves em tabelas criadas vazias. Com o crescimento incremental, nenhuma
+// insercao paga a reconstrucao inteira; o unordered_map, que reconstroi tudo de uma vez
+// ao crescer, serve de referencia para a pior latencia.
+void benchmarkGrowth(const vector<string>& keys) {
+    HashTable<FibonacciHash> table;
+    measureLatency("Crescimento incremental", keys, [&](const string& key) { table.insert(key, "Nome"); });
+    HashTableStats stats = table.getStats();
+    cout << "  Estatisticas: " << stats.count << " chaves, " << stats.capacity << " posicoes, carga "
+         << stats.loadFactor << ", sondagem media " << stats.averageProbe << ", maior sondagem "
+         << stats.longestProbe << ", " << stats.pendingMigration << " chaves ainda migrando, "
+         << stats.poolBytes << " bytes no pool" << endl;
+    // As buscas tambem avancam a migracao: uma carga so de leituras esvazia a tabela antiga
+    size_t encontradas = 0;
+    for (const string& key : keys) encontradas += table.contains(key);
+    cout << "  Depois de " << keys.size() << " buscas: " << table.getStats().pendingMigration
+         << " chaves ainda migrando (" << encontradas << " encontradas)" << endl;
+
+    unordered_map<string, string> referencia;
+    measureLatency("unordered_map", keys, [&](const string& key) { referencia.emplace(key, "Nome"); });
+}
+
+// Compara a tabela encadeada original com a de enderecamento aberto, ambas
+// dimensionadas para n chaves. A tabela aberta roda com hashDivisao (pelo adaptador
+// FunctionHash, como antes) e com o FibonacciHash, chamado sem indirecao.
+void benchmark(size_t n) {
+    cout << "=== Tabelas hash com " << n << " chaves ===" << endl;
+    vector<string> keys = generateKeys(n, 12345);
+    vector<string> misses = generateKeys(n, 777);
+    for (string& key : misses) key.insert(0, "9"); // 12 digitos: nunca coincide com as chaves
+    vector<string> lookups = keys;
+    shuffle(lookups.begin(), lookups.end(), mt19937_64(42));
+    {
+        ChainedHashTable encadeada(n, hashDivisao);
+        benchmarkTable("Encadeamento externo", encadeada, keys, lookups, misses);
+    }
+    {
+        HashTable<FunctionHash> aberta(n, FunctionHash(hashDivisao));
+        benchmarkTable("Enderecamento aberto (hashDivisao)", aberta, keys, lookups, misses);
+    }
+    {
+        HashTable<FibonacciHash> aberta(n);
+        benchmarkTable("Enderecamento aberto (Fibonacci)", aberta, keys, lookups, misses);
+    }
+    benchmarkGrowth(keys);
+}
+
+// Recebe a soma dos hashes medidos, para que o compilador nao descarte o laco.
+volatile uint64_t hashSink;
+
+// Referencia para o benchmark de funcoes de hash: o std::hash da biblioteca padrao.
+struct StdHash {
+    uint64_t operator()(string_view key) const { return hash<string_view>()(key); }
 };
 
-// Classe da tabela hash com encadeamento externo
-class HashTable {
-private:
-    vector<Node*> table; // vetor de ponteiros para listas
-    size_t size;         // tamanho da tabela
-    function<size_t(const string&)> dispersionFunction; // funcao de hash
+// Gera n chaves no formato de dados_ed.csv: ids de 11 digitos em sequencia
+// ("00000000000", "00000000001"...), o pior caso para hashes que so usam os ultimos digitos.
+vector<string> generateSequentialKeys(size_t n) {
+    vector<string> keys;
+    keys.reserve(n);
+    char texto[24];
+    for (size_t i = 0; i < n; ++i) {
+        snprintf(texto, sizeof(texto), "%011zu", i);
+        keys.push_back(texto);
+    }
+    return keys;
+}
 
-public:
-    // Construtor recebe o tamanho e a funcao de hash
-    HashTable(size_t sz, function<size_t(const string&)> func)
-        : size(sz), dispersionFunction(func) {
-        table.resize(size, nullptr); // inicializa a tabela com nulos
+// Gera n nomes distintos ("Ana Souza 17", "Beto Lima 17"...), como a coluna de nomes.
+vector<string> generateNames(size_t n) {
+    const char* nomes[] = {"Ana", "Beto", "Carlos", "Daniela", "Eduardo", "Fernanda", "Gabriel", "Helena"};
+    const char* sobrenomes[] = {"Silva", "Souza", "Oliveira", "Santos", "Lima", "Pereira", "Costa", "Almeida"};
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(string(nomes[i % 8]) + ' ' + sobrenomes[(i / 8) % 8] + ' ' + to_string(i / 64));
     }
+    return keys;
+}
+
+// Mede uma funcao de hash sobre um conjunto de chaves:
+//  * vazao: milhoes de hashes por segundo;
+//  * distribuicao: as chaves sao espalhadas em tantas posicoes quanto a menor potencia
+//    de 2 >= n, pelos bits altos do hash (como na HashTable). "Razao" e a soma de
+//    b(b+1)/2 sobre as posicoes dividida pelo valor esperado para um hash uniforme:
+//    perto de 1 e o ideal, acima de 1 indica agrupamento;
+//  * a tabela: tempo de insercao em uma HashTable<Hash> vazia e as sondagens resultantes.
+template <typename Hash>
+void benchmarkHash(const string& nome, const vector<string>& keys, Hash hasher = Hash()) {
+    uint64_t soma = 0;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (const string& key : keys) soma += hasher(key);
+    double segundos = secondsSince(inicio);
+    hashSink = soma;
+
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < keys.size()) ++bits;
+    size_t posicoes = static_cast<size_t>(1) << bits;
+    vector<uint32_t> ocupacao(posicoes, 0);
+    for (const string& key : keys) {
+        uint64_t h = hasher(key);
+        ++ocupacao[bits == 0 ? 0 : h >> (64 - bits)];
+    }
+    double n = static_cast<double>(keys.size());
+    double m = static_cast<double>(posicoes);
+    double observado = 0;
+    uint32_t maior = 0;
+    for (uint32_t b : ocupacao) {
+        observado += b * (b + 1.0) / 2;
+        maior = max(maior, b);
+    }
+    double esperado = n / (2 * m) * (n + 2 * m - 1);
+
+    HashTable<Hash> table(0, hasher);
+    inicio = chrono::steady_clock::now();
+    for (const string& key : keys) table.insert(key, "Nome");
+    double insercao = secondsSince(inicio);
+    HashTableStats stats = table.getStats();
 
-    // Insere um novo par (chave, valor), se nao for duplicata
-    void insert(const string& key, const string& value) {
-        if (!search(key).empty()) return; // nao insere duplicata
+    cout << "  " << nome << ": " << keys.size() / segundos / 1e6 << " Mhash/s, razao "
+         << observado / esperado << ", maior posicao " << maior << ", insercao "
+         << keys.size() / insercao / 1e6 << " Mops/s, sondagem media " << stats.averageProbe
+         << ", maior sondagem " << stats.longestProbe << endl;
+}
 
-        size_t index = dispersionFunction(key) % size;
-        Node* newNode = new Node(key, value);
+// Compara as funcoes de hash em chaves no formato de dados_ed.csv (ids numericos
+// aleatorios e sequenciais) e em nomes. hashDivisao so aceita chaves numericas.
+void benchmarkHashes(size_t n) {
+    cout << "=== Funcoes de hash com " << n << " chaves ===" << endl;
+    const char* conjuntos[] = {"ids aleatorios", "ids sequenciais", "nomes"};
+    for (int c = 0; c < 3; ++c) {
+        vector<string> keys = c == 0 ? generateKeys(n, 12345) : c == 1 ? generateSequentialKeys(n) : generateNames(n);
+        cout << conjuntos[c] << ":" << endl;
+        if (c < 2) benchmarkHash("hashDivisao", keys, FunctionHash(hashDivisao));
+        benchmarkHash<FibonacciHash>("FibonacciHash", keys);
+        benchmarkHash<StringHash>("StringHash", keys);
+        benchmarkHash<StdHash>("std::hash", keys);
+    }
+}
 
-        if (table[index] == nullptr) {
-            table[index] = newNode;
+// Gera um CSV no formato de dados_ed.csv (id,nome) com n linhas, das quais cerca de um
+// quarto repete um id anterior. Alguns nomes vem entre aspas, com virgula ou aspas
+// internas, para exercitar o caminho lento do leitor. Com 'quebrasDeLinha', metade dos
+// nomes vem entre aspas com uma quebra de linha (registros de duas linhas).
+void writeBenchmarkCsv(const string& path, size_t n, bool quebrasDeLinha = false) {
+    vector<string> ids = generateKeys(n - n / 4, 4242);
+    vector<string> nomes = generateNames(n);
+    FILE* saida = fopen(path.c_str(), "wb");
+    if (saida == nullptr) throw runtime_error("nao foi possivel criar " + path);
+    vector<char> buffer(1 << 20);
+    setvbuf(saida, buffer.data(), _IOFBF, buffer.size());
+    fputs("id,nome\n", saida);
+    mt19937_64 rng(7);
+    for (size_t i = 0; i < n; ++i) {
+        const string& id = i < ids.size() ? ids[i] : ids[rng() % ids.size()];
+        if (i % 64 == 0) {
+            fprintf(saida, "%s,\"%s, \"\"Jr\"\"\"\r\n", id.c_str(), nomes[i].c_str());
+        } else if (quebrasDeLinha && i % 2 == 1) {
+            fprintf(saida, "%s,\"%s\n%s\"\r\n", id.c_str(), nomes[i].c_str(), ids[rng() % ids.size()].c_str());
         } else {
-            Node* current = table[index];
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newNode;
+            fprintf(saida, "%s,%s\r\n", id.c_str(), nomes[i].c_str());
         }
     }
+    fclose(saida);
+}
 
-    // Retorna o valor associado a uma chave (ou string vazia se nao existir)
-    string search(const string& key) const {
-        size_t index = dispersionFunction(key) % size;
-        Node* current = table[index];
-        while (current != nullptr) {
-            if (current->key == key)
-                return current->value;
-            current = current->next;
-        }
-        return "";
-    }
-
-    // Remove um par (chave, valor) se a chave existir
-    bool remove(const string& key) {
-        size_t index = dispersionFunction(key) % size;
-        Node* current = table[index];
-        Node* previous = nullptr;
-
-        while (current != nullptr) {
-            if (current->key == key) {
-                if (previous == nullptr) {
-                    table[index] = current->next;
-                } else {
-                    previous->next = current->next;
-                }
-                delete current;
-                return true;
-            }
-            previous = current;
-            current = current->next;
+// Mede a leitura de um CSV em GB/s: so a divisao em campos e a eliminacao de duplicatas
+// completa, com getline/stringstream (versao original) e com o CsvReader.
+void benchmarkIngestion(size_t n) {
+    const string path = "bench_ingestao.csv";
+    cout << "=== Leitura de CSV com " << n << " linhas ===" << endl;
+    writeBenchmarkCsv(path, n);
+    ifstream tamanho(path, ios::binary | ios::ate);
+    double gigabytes = static_cast<double>(tamanho.tellg()) / 1e9;
+    cout << "  arquivo: " << gigabytes * 1e3 << " MB" << endl;
+
+    size_t bytes = 0;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    {
+        ifstream file(path);
+        string line;
+        while (getline(file, line)) {
+            stringstream ss(line);
+            string key, value;
+            getline(ss, key, ',');
+            getline(ss, value, ',');
+            bytes += key.size() + value.size();
         }
-        return false;
     }
+    double segundos = secondsSince(inicio);
+    cout << "  getline + stringstream - divisao em campos: " << segundos << " s ("
+         << gigabytes / segundos << " GB/s)" << endl;
 
-    // Imprime todos os pares (chave, valor) armazenados
-    void print() const {
-        for (size_t i = 0; i < size; ++i) {
-            Node* current = table[i];
-            while (current != nullptr) {
-                cout << current->key << " " << current->value << endl;
-                current = current->next;
-            }
+    inicio = chrono::steady_clock::now();
+    {
+        CsvReader reader(path);
+        vector<string_view> fields;
+        while (reader.next(fields)) {
+            for (string_view field : fields) bytes += field.size();
         }
     }
+    segundos = secondsSince(inicio);
+    cout << "  CsvReader - divisao em campos: " << segundos << " s (" << gigabytes / segundos
+         << " GB/s)" << endl;
+    hashSink = bytes;
 
-    // Destrutor libera a memoria dos nos
-    ~HashTable() {
-        for (size_t i = 0; i < size; ++i) {
-            Node* current = table[i];
-            while (current) {
-                Node* toDelete = current;
-                current = current->next;
-                delete toDelete;
-            }
-        }
+    inicio = chrono::steady_clock::now();
+    size_t antigas = eliminateDuplicateGetline<FibonacciHash>(path).getCount();
+    segundos = secondsSince(inicio);
+    cout << "  getline + stringstream - eliminacao de duplicatas: " << segundos << " s ("
+         << gigabytes / segundos << " GB/s, " << antigas << " chaves)" << endl;
+
+    inicio = chrono::steady_clock::now();
+    size_t novas = eliminateDuplicate<FibonacciHash>(path).getCount();
+    segundos = secondsSince(inicio);
+    cout << "  CsvReader - eliminacao de duplicatas: " << segundos << " s ("
+         << gigabytes / segundos << " GB/s, " << novas << " chaves)" << endl;
+    std::remove(path.c_str());
+}
+
+// Resumo da saida de uma eliminacao de duplicatas: combina os hashes das chaves na
+// ordem em que seriam impressas, para comparar as versoes sem gerar a saida.
+template <typename Table>
+uint64_t outputFingerprint(const Table& table) {
+    uint64_t resumo = 0;
+    table.forEach([&](string_view key, string_view value) {
+        resumo = (resumo ^ StringHash()(key)) * 1099511628211ULL + StringHash()(value);
+    });
+    return resumo;
+}
+
+// Compara a eliminacao de duplicatas sequencial com a paralela, de 1 thread ate o
+// numero de nucleos (no minimo 4), e confere se a saida e a mesma.
+void benchmarkParallel(size_t n, bool quebrasDeLinha) {
+    const string path = "bench_paralelo.csv";
+    cout << "=== Eliminacao de duplicatas em paralelo com " << n << " linhas"
+         << (quebrasDeLinha ? ", com quebras de linha entre aspas" : "") << " ===" << endl;
+    writeBenchmarkCsv(path, n, quebrasDeLinha);
+    ifstream tamanho(path, ios::binary | ios::ate);
+    double gigabytes = static_cast<double>(tamanho.tellg()) / 1e9;
+    size_t nucleos = thread::hardware_concurrency();
+    cout << "  arquivo: " << gigabytes * 1e3 << " MB, " << nucleos << " nucleos" << endl;
+
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    HashTable<FibonacciHash> sequencial = eliminateDuplicate<FibonacciHash>(path);
+    double segundos = secondsSince(inicio);
+    cout << "  sequencial: " << segundos << " s (" << gigabytes / segundos << " GB/s, "
+         << sequencial.getCount() << " chaves)" << endl;
+    uint64_t esperado = outputFingerprint(sequencial);
+
+    for (size_t threads = 1; threads <= max<size_t>(nucleos, 4); threads *= 2) {
+        inicio = chrono::steady_clock::now();
+        PartitionedHashTable<FibonacciHash> paralela = eliminateDuplicateParallel<FibonacciHash>(path, threads);
+        segundos = secondsSince(inicio);
+        cout << "  " << threads << " threads: " << segundos << " s (" << gigabytes / segundos << " GB/s, "
+             << paralela.getCount() << " chaves, saida "
+             << (outputFingerprint(paralela) == esperado ? "igual" : "DIFERENTE") << " a sequencial)" << endl;
     }
+    std::remove(path.c_str());
+}
+
+// Repete a comparacao com um arquivo em que parte dos nomes tem quebras de linha entre
+// aspas, que os cortes dos trechos da versao paralela nao podem separar.
+void benchmarkParallel(size_t n) {
+    benchmarkParallel(n, false);
+    benchmarkParallel(n, true);
+}
+
+// Resumo da saida que nao depende da ordem das chaves: numero de chaves e soma dos
+// hashes de (chave, valor).
+struct SetFingerprint {
+    size_t count;
+    uint64_t sum;
+    bool operator==(const SetFingerprint& outro) const { return count == outro.count && sum == outro.sum; }
 };
 
-// Funcao de dispersao (hash) baseada em divisao
-size_t hashDivisao(const string& key) {
-    return stoull(key); // assume que a chave e numerica
+SetFingerprint addToFingerprint(SetFingerprint resumo, string_view key, string_view value) {
+    ++resumo.count;
+    resumo.sum += mixBits(StringHash()(key) ^ (StringHash()(value) * 31));
+    return resumo;
 }
 
-// Funao que elimina duplicatas de um arquivo CSV
-HashTable eliminateDuplicate(const string& dataset_path,
-                              function<size_t(const string&)> dispersionFunc) {
-    HashTable table_hash(120, dispersionFunc);
-    ifstream file(dataset_path);
-    string line;
+// Compara a eliminacao de duplicatas na memoria com a versao com memoria limitada a
+// 'mb' MB (por padrao, cerca de um oitavo do que a versao na memoria usa) e confere se as
+// duas produzem o mesmo conjunto de pares.
+void benchmarkExternal(size_t n, size_t mb) {
+    const string path = "bench_externa.csv";
+    const string saida = "bench_externa_saida.csv";
+    cout << "=== Eliminacao de duplicatas com memoria limitada, " << n << " linhas ===" << endl;
+    writeBenchmarkCsv(path, n);
+    ifstream tamanho(path, ios::binary | ios::ate);
+    double gigabytes = static_cast<double>(tamanho.tellg()) / 1e9;
 
-    getline(file, line); // pula o cabecalho
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    HashTable<FibonacciHash> memoria = eliminateDuplicate<FibonacciHash>(path);
+    double segundos = secondsSince(inicio);
+    size_t bytes = memoria.getMemoryBytes();
+    cout << "  na memoria: " << segundos << " s (" << gigabytes / segundos << " GB/s, "
+         << memoria.getCount() << " chaves, tabela com " << bytes / (1024 * 1024) << " MB)" << endl;
+    SetFingerprint esperado = {0, 0};
+    memoria.forEach([&](string_view key, string_view value) { esperado = addToFingerprint(esperado, key, value); });
+    memoria = HashTable<FibonacciHash>();
 
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string key, value;
-        getline(ss, key, ',');
-        getline(ss, value, ',');
+    if (mb == 0) mb = max<size_t>(bytes / (8 * 1024 * 1024), 1);
+    inicio = chrono::steady_clock::now();
+    ExternalDedupStats stats = eliminateDuplicateExternal<FibonacciHash>(path, saida, mb);
+    segundos = secondsSince(inicio);
+    cout << "  limite de " << mb << " MB: " << segundos << " s (" << gigabytes / segundos << " GB/s, "
+         << stats.uniqueKeys << " chaves, " << stats.spilledRows << " registros em "
+         << stats.partitionFiles << " particoes, " << stats.maxDepth << " niveis)" << endl;
 
-        table_hash.insert(key, value); // so insere se nao for duplicado
+    SetFingerprint obtido = {0, 0};
+    {
+        CsvReader reader(saida);
+        vector<string_view> fields;
+        reader.next(fields); // cabecalho
+        while (reader.next(fields)) obtido = addToFingerprint(obtido, fields[0], fields[1]);
     }
-
-    return table_hash;
+    cout << "  mesmos pares que a versao na memoria: " << (obtido == esperado ? "sim" : "NAO") << endl;
+    std::remove(path.c_str());
+    std::remove(saida.c_str());
 }
 
 // Funcao principal
-int main() {
+// Uso: ./hash_table [arquivo.csv] [--threads n]
+//      ./hash_table [arquivo.csv] --memoria mb [--saida saida.csv]
+//      ./hash_table --bench [n] | --bench-hash [n] | --bench-csv [n] | --bench-parallel [n]
+//      ./hash_table --bench-external [n] [mb]
+// Com --threads, a eliminacao de duplicatas usa n threads (0: uma por nucleo).
+// Com --memoria, a tabela usa no maximo cerca de mb MB: o excedente vai para particoes
+// no disco, e o CSV sem duplicatas e escrito em --saida (padrao: saida padrao).
+// Compilar com -pthread.
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        size_t n = argc > 2 ? stoull(argv[2]) : 10000000;
+        benchmark(n);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-hash") {
+        size_t n = argc > 2 ? stoull(argv[2]) : 1000000;
+        benchmarkHashes(n);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-csv") {
+        size_t n = argc > 2 ? stoull(argv[2]) : 10000000;
+        benchmarkIngestion(n);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-parallel") {
+        size_t n = argc > 2 ? stoull(argv[2]) : 10000000;
+        benchmarkParallel(n);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-external") {
+        size_t n = argc > 2 ? stoull(argv[2]) : 10000000;
+        size_t mb = argc > 3 ? stoull(argv[3]) : 0;
+        benchmarkExternal(n, mb);
+        return 0;
+    }
+
     string path = "dados.csv"; // nome do arquivo CSV
+    bool parallel = false;
+    size_t threads = 0;
+    size_t memoryMb = 0;
+    string output = "-";
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--threads") {
+            parallel = true;
+            threads = i + 1 < argc ? stoull(argv[++i]) : 0;
+        } else if (string(argv[i]) == "--memoria" && i + 1 < argc) {
+            memoryMb = stoull(argv[++i]);
+        } else if (string(argv[i]) == "--saida" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            path = argv[i];
+        }
+    }
+    if (memoryMb > 0) {
+        try {
+            ExternalDedupStats stats = eliminateDuplicateExternal<FibonacciHash>(path, output, memoryMb);
+            cerr << stats.rows << " registros, " << stats.uniqueKeys << " chaves unicas, "
+                 << stats.spilledRows << " registros em " << stats.partitionFiles << " particoes no disco"
+                 << endl;
+        } catch (const runtime_error& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (parallel) {
+        if (threads == 0) threads = max<size_t>(thread::hardware_concurrency(), 1);
+        try {
+            PartitionedHashTable<FibonacciHash> tabela = eliminateDuplicateParallel<FibonacciHash>(path, threads);
+            cout << "Chaves unicas (sem duplicatas):\n";
+            tabela.print();
+        } catch (const runtime_error& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    // Cria a tabela hash usando a funcao de divisao
-    HashTable tabela = eliminateDuplicate(path, hashDivisao);
+    // Cria a tabela hash usando o hashing de Fibonacci sobre os ids numericos
+    HashTable<FibonacciHash> tabela;
+    try {
+        tabela = eliminateDuplicate<FibonacciHash>(path);
+    } catch (const runtime_error& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
 
     cout << "Chaves unicas (sem duplicatas):\n";
     tabela.print(); // imprime os dados sem repeticoes
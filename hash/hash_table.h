@@ -0,0 +1,551 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "hash_functions.h"
+
+// Estrutura de um no encadeado
+class Node {
+public:
+    std::string key;       // campo chave (por exemplo: cpf ou id)
+    std::string value;     // campo valor (por exemplo: nome)
+    Node* next;
+
+    Node(std::string k, std::string v) : key(k), value(v), next(nullptr) {}
+};
+
+// Tabela hash com encadeamento externo (versao original).
+// Mantida como referencia para o benchmark da tabela com enderecamento aberto.
+class ChainedHashTable {
+private:
+    std::vector<Node*> table; // vetor de ponteiros para listas
+    size_t size;         // tamanho da tabela
+    std::function<size_t(const std::string&)> dispersionFunction; // funcao de hash
+
+public:
+    // Construtor recebe o tamanho e a funcao de hash
+    ChainedHashTable(size_t sz, std::function<size_t(const std::string&)> func)
+        : size(sz), dispersionFunction(func) {
+        table.resize(size, nullptr); // inicializa a tabela com nulos
+    }
+
+    ChainedHashTable(const ChainedHashTable&) = delete;
+    ChainedHashTable& operator=(const ChainedHashTable&) = delete;
+
+    // Insere um novo par (chave, valor), se nao for duplicata
+    void insert(const std::string& key, const std::string& value) {
+        if (!search(key).empty()) return; // nao insere duplicata
+
+        size_t index = dispersionFunction(key) % size;
+        Node* newNode = new Node(key, value);
+
+        if (table[index] == nullptr) {
+            table[index] = newNode;
+        } else {
+            Node* current = table[index];
+            while (current->next != nullptr) {
+                current = current->next;
+            }
+            current->next = newNode;
+        }
+    }
+
+    // Retorna o valor associado a uma chave (ou string vazia se nao existir)
+    std::string search(const std::string& key) const {
+        size_t index = dispersionFunction(key) % size;
+        Node* current = table[index];
+        while (current != nullptr) {
+            if (current->key == key)
+                return current->value;
+            current = current->next;
+        }
+        return "";
+    }
+
+    // Remove um par (chave, valor) se a chave existir
+    bool remove(const std::string& key) {
+        size_t index = dispersionFunction(key) % size;
+        Node* current = table[index];
+        Node* previous = nullptr;
+
+        while (current != nullptr) {
+            if (current->key == key) {
+                if (previous == nullptr) {
+                    table[index] = current->next;
+                } else {
+                    previous->next = current->next;
+                }
+                delete current;
+                return true;
+            }
+            previous = current;
+            current = current->next;
+        }
+        return false;
+    }
+
+    // Imprime todos os pares (chave, valor) armazenados
+    void print() const {
+        for (size_t i = 0; i < size; ++i) {
+            Node* current = table[i];
+            while (current != nullptr) {
+                std::cout << current->key << " " << current->value << std::endl;
+                current = current->next;
+            }
+        }
+    }
+
+    // Destrutor libera a memoria dos nos
+    ~ChainedHashTable() {
+        for (size_t i = 0; i < size; ++i) {
+            Node* current = table[i];
+            while (current) {
+                Node* toDelete = current;
+                current = current->next;
+                delete toDelete;
+            }
+        }
+    }
+};
+
+
+// Pool dos pares (chave, valor), gravados em sequencia na ordem de insercao:
+//   [tamanho da chave: 4 bytes][tamanho do valor: 4 bytes][chave][valor][alinhamento a 8 bytes]
+// O pool e dividido em blocos de 1 MB: crescer so aloca um bloco novo, e os pares ja
+// gravados nunca sao copiados (um vetor unico copiaria o pool inteiro a cada duplicacao).
+// Cada par e identificado por uma posicao de 32 bits: bloco e deslocamento em unidades
+// de 8 bytes. Um par maior que um bloco ocupa um bloco so dele.
+class PairPool {
+public:
+    PairPool() : bytes(0), removedBytes(0) {}
+
+    // Grava o par e retorna a sua posicao.
+    uint32_t append(const char* key, uint32_t keySize, const char* value, uint32_t valueSize) {
+        size_t size = recordSize(keySize, valueSize);
+        if (chunks.empty() || used.back() + size > CHUNK_SIZE) {
+            if (chunks.size() >= MAX_CHUNKS) {
+                throw std::length_error("PairPool: pool com mais de 32 GB.");
+            }
+            chunks.emplace_back(new char[size > CHUNK_SIZE ? size : CHUNK_SIZE]);
+            used.push_back(0);
+        }
+        char* destino = chunks.back().get() + used.back();
+        memcpy(destino, &keySize, sizeof(keySize));
+        memcpy(destino + sizeof(keySize), &valueSize, sizeof(valueSize));
+        if (keySize > 0) memcpy(destino + HEADER, key, keySize); // string_views vazias podem ser nulas
+        if (valueSize > 0) memcpy(destino + HEADER + keySize, value, valueSize);
+        uint32_t position = static_cast<uint32_t>((chunks.size() - 1) * BLOCKS_PER_CHUNK + used.back() / BLOCK);
+        used.back() += size;
+        bytes += size;
+        return position;
+    }
+
+    const char* key(uint32_t position) const { return record(position) + HEADER; }
+    const char* value(uint32_t position) const { return key(position) + keySize(position); }
+    uint32_t keySize(uint32_t position) const { return readSize(record(position)) & ~REMOVED; }
+    uint32_t valueSize(uint32_t position) const { return readSize(record(position) + sizeof(uint32_t)); }
+
+    // Marca o par como removido. O espaco so e recuperado junto com o pool inteiro.
+    void markRemoved(uint32_t position) {
+        char* inicio = chunks[position / BLOCKS_PER_CHUNK].get() + (position % BLOCKS_PER_CHUNK) * BLOCK;
+        uint32_t size = readSize(inicio);
+        removedBytes += recordSize(size, valueSize(position));
+        size |= REMOVED;
+        memcpy(inicio, &size, sizeof(size));
+    }
+
+    // Chama visit(chave, tamanho da chave, valor, tamanho do valor) para cada par
+    // presente, na ordem de insercao.
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+            size_t offset = 0;
+            while (offset < used[chunk]) {
+                const char* inicio = chunks[chunk].get() + offset;
+                uint32_t keySize = readSize(inicio);
+                uint32_t valueSize = readSize(inicio + sizeof(uint32_t));
+                bool removed = (keySize & REMOVED) != 0;
+                keySize &= ~REMOVED;
+                if (!removed) visit(inicio + HEADER, keySize, inicio + HEADER + keySize, valueSize);
+                offset += recordSize(keySize, valueSize);
+            }
+        }
+    }
+
+    // Bytes ocupados pelos pares (incluindo os removidos) e so pelos removidos.
+    size_t getBytes() const { return bytes; }
+    size_t getRemovedBytes() const { return removedBytes; }
+
+private:
+    static const uint32_t REMOVED = 0x80000000u; // bit marcado no tamanho da chave de um par removido
+    static const size_t HEADER = 2 * sizeof(uint32_t);
+    static const size_t BLOCK = 8;
+    static const size_t CHUNK_SIZE = 1 << 20;
+    static const size_t BLOCKS_PER_CHUNK = CHUNK_SIZE / BLOCK;
+    static const size_t MAX_CHUNKS = (1ULL << 32) / BLOCKS_PER_CHUNK - 1; // posicoes cabem em 32 bits
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::vector<size_t> used; // bytes usados em cada bloco
+    size_t bytes;
+    size_t removedBytes;
+
+    static size_t recordSize(uint32_t keySize, uint32_t valueSize) {
+        return (HEADER + keySize + valueSize + BLOCK - 1) / BLOCK * BLOCK;
+    }
+
+    static uint32_t readSize(const char* inicio) {
+        uint32_t size;
+        memcpy(&size, inicio, sizeof(size));
+        return size;
+    }
+
+    const char* record(uint32_t position) const {
+        return chunks[position / BLOCKS_PER_CHUNK].get() + (position % BLOCKS_PER_CHUNK) * BLOCK;
+    }
+};
+
+// Estatisticas de uma HashTable (ver HashTable::getStats).
+struct HashTableStats {
+    size_t count;            // chaves presentes
+    size_t capacity;         // posicoes da tabela atual
+    size_t tombstones;       // posicoes marcadas como removidas na tabela atual
+    double loadFactor;       // chaves na tabela atual / capacidade (sem as que ainda estao na antiga)
+    size_t longestProbe;     // maior distancia de uma chave ate a sua posicao de origem
+    double averageProbe;     // distancia media (0 = a chave esta na posicao de origem)
+    size_t pendingMigration; // chaves ainda na tabela antiga, durante um crescimento
+    size_t poolBytes;        // bytes do pool de pares (incluindo pares removidos)
+};
+
+// Tabela hash com enderecamento aberto e sondagem linear.
+// A funcao de hash e o parametro 'Hash' (ver hash_functions.h): um objeto com
+// 'uint64_t operator()(string_view) const', chamado diretamente, sem std::function.
+// A posicao de origem de uma chave vem dos bits altos do hash; os 32 bits baixos
+// sao a etiqueta comparada antes da chave.
+//
+// As posicoes da tabela ficam em um unico vetor contiguo (24 bytes cada), com a posicao
+// do par no pool, 32 bits do hash (comparados antes da chave, entao uma colisao quase
+// nunca precisa ler a chave) e uma copia das chaves curtas (ate 15 bytes, como CPFs e
+// ids): para elas, inserir uma duplicata ou verificar se a chave existe toca so a posicao.
+// Os pares ficam no PairPool, na ordem de insercao, sem um no alocado por par.
+//
+// A remocao deixa uma marca ("tombstone") na posicao, para nao interromper a sondagem
+// das chaves que vieram depois.
+//
+// Crescimento incremental: quando posicoes ocupadas + marcas passam de 3/4 da
+// capacidade, uma tabela nova (o dobro, se preciso) passa a receber as insercoes, e a
+// antiga e esvaziada aos poucos: cada insercao, remocao ou busca migra MIGRATION_STEP
+// posicoes (por isso search e contains nao sao const). Nenhuma operacao paga a
+// reconstrucao inteira; durante a migracao, as buscas consultam as duas tabelas. As tabelas sao alocadas com calloc, entao criar uma tabela grande nao
+// exige escrever nela: as paginas zeradas vem do sistema conforme sao usadas.
+template <typename Hash = StringHash>
+class HashTable {
+private:
+    // Posicao da tabela.
+    struct Slot {
+        uint32_t position;        // EMPTY, TOMBSTONE ou posicao do par no pool + FIRST_POSITION
+        uint32_t tag;             // 32 bits baixos do hash
+        uint8_t keySize;          // tamanho da chave, ou LONG_KEY se ela so estiver no pool
+        char shortKey[15];        // copia da chave curta
+    };
+
+    static const uint32_t EMPTY = 0;     // calloc ja entrega as posicoes vazias
+    static const uint32_t TOMBSTONE = 1;
+    static const uint32_t FIRST_POSITION = 2;
+    static const size_t INLINE_KEY = sizeof(Slot::shortKey);
+    static const uint8_t LONG_KEY = 0xFF;
+    static const size_t MIN_CAPACITY = 16;
+    // Posicoes da tabela antiga migradas por operacao. A tabela nova comeca com carga
+    // de no maximo 1/2 e so cresce de novo acima de 3/4: sobram pelo menos capacidade/4
+    // insercoes, tempo suficiente para migrar a antiga (que tem no maximo a mesma capacidade).
+    static const size_t MIGRATION_STEP = 4;
+
+    // Vetor de posicoes alocado com calloc (so pode ser movido, nao copiado).
+    class SlotArray {
+    public:
+        SlotArray() : data(nullptr), length(0) {}
+        explicit SlotArray(size_t n) : data(static_cast<Slot*>(calloc(n, sizeof(Slot)))), length(n) {
+            if (data == nullptr) throw std::bad_alloc();
+        }
+        SlotArray(SlotArray&& outra) noexcept : data(outra.data), length(outra.length) {
+            outra.data = nullptr;
+            outra.length = 0;
+        }
+        SlotArray& operator=(SlotArray&& outra) noexcept {
+            std::swap(data, outra.data);
+            std::swap(length, outra.length);
+            return *this;
+        }
+        ~SlotArray() { free(data); }
+
+        Slot& operator[](size_t i) { return data[i]; }
+        const Slot& operator[](size_t i) const { return data[i]; }
+        size_t size() const { return length; }
+
+    private:
+        Slot* data;
+        size_t length;
+    };
+
+    SlotArray slots;        // tabela atual, capacidade sempre potencia de 2
+    size_t mask;            // capacidade - 1
+    unsigned shift;         // 64 - log2(capacidade): a posicao de origem e hash >> shift
+    SlotArray oldSlots;     // tabela sendo migrada (vazia fora de um crescimento)
+    size_t oldMask;
+    unsigned oldShift;
+    size_t migrated;        // proxima posicao de oldSlots a migrar
+    size_t oldCount;        // chaves ainda em oldSlots
+    PairPool pool;
+    size_t count;           // chaves presentes (nas duas tabelas)
+    size_t tombstones;      // marcas na tabela atual
+    Hash hasher;            // funcao de hash
+
+    uint64_t hashOf(const char* key, size_t keySize) const {
+        return hasher(std::string_view(key, keySize));
+    }
+
+    static unsigned shiftFor(size_t capacity) {
+        unsigned bits = 0;
+        while ((static_cast<size_t>(1) << bits) < capacity) ++bits;
+        return 64 - bits;
+    }
+
+    bool migrating() const { return oldSlots.size() != 0; }
+
+    // Compara a chave da posicao (a copia curta ou, se a chave for longa, a do pool).
+    bool matches(const Slot& slot, const char* key, size_t keySize) const {
+        if (slot.keySize != LONG_KEY) {
+            return slot.keySize == keySize && memcmp(slot.shortKey, key, keySize) == 0;
+        }
+        uint32_t position = slot.position - FIRST_POSITION;
+        return keySize > INLINE_KEY && pool.keySize(position) == keySize &&
+               memcmp(pool.key(position), key, keySize) == 0;
+    }
+
+    // Percorre a sequencia de sondagem da chave em 'table'. Retorna a posicao onde ela
+    // esta, ou (se nao estiver) a posicao onde deve ser inserida: a primeira marca
+    // encontrada no caminho ou a posicao vazia que encerrou a busca. 'found' indica qual.
+    size_t probe(const SlotArray& table, size_t tableMask, unsigned tableShift, const char* key,
+                 size_t keySize, uint64_t h, bool& found) const {
+        uint32_t tag = static_cast<uint32_t>(h);
+        size_t index = h >> tableShift;
+        size_t firstTombstone = SIZE_MAX;
+        while (true) {
+            const Slot& slot = table[index];
+            if (slot.position == EMPTY) {
+                found = false;
+                return firstTombstone != SIZE_MAX ? firstTombstone : index;
+            }
+            if (slot.position == TOMBSTONE) {
+                if (firstTombstone == SIZE_MAX) firstTombstone = index;
+            } else if (slot.tag == tag && matches(slot, key, keySize)) {
+                found = true;
+                return index;
+            }
+            index = (index + 1) & tableMask;
+        }
+    }
+
+    // Procura a chave na tabela atual e, durante um crescimento, na antiga.
+    // Retorna a posicao encontrada (ou nullptr); 'inOld' indica se ela esta na antiga.
+    const Slot* find(const char* key, size_t keySize, uint64_t h, bool& inOld) const {
+        bool found;
+        size_t index = probe(slots, mask, shift, key, keySize, h, found);
+        inOld = false;
+        if (found) return &slots[index];
+        if (migrating()) {
+            index = probe(oldSlots, oldMask, oldShift, key, keySize, h, found);
+            inOld = true;
+            if (found) return &oldSlots[index];
+        }
+        return nullptr;
+    }
+
+    // Ocupa slots[index] com o par da posicao 'position' do pool.
+    void place(size_t index, uint64_t h, const char* key, size_t keySize, uint32_t position) {
+        Slot& slot = slots[index];
+        if (slot.position == TOMBSTONE) --tombstones;
+        slot.position = position + FIRST_POSITION;
+        slot.tag = static_cast<uint32_t>(h);
+        if (keySize <= INLINE_KEY) {
+            slot.keySize = static_cast<uint8_t>(keySize);
+            memcpy(slot.shortKey, key, keySize);
+        } else {
+            slot.keySize = LONG_KEY;
+        }
+    }
+
+    // Migra ate 'steps' posicoes da tabela antiga para a atual.
+    void migrate(size_t steps) {
+        size_t end = migrated + steps < oldSlots.size() ? migrated + steps : oldSlots.size();
+        for (; migrated < end; ++migrated) {
+            Slot& slot = oldSlots[migrated];
+            if (slot.position < FIRST_POSITION) continue;
+            uint32_t position = slot.position - FIRST_POSITION;
+            const char* key = pool.key(position);
+            uint32_t keySize = pool.keySize(position);
+            uint64_t h = hashOf(key, keySize);
+            // A chave nao esta na tabela atual: basta achar a primeira posicao livre.
+            size_t index = h >> shift;
+            while (slots[index].position >= FIRST_POSITION) index = (index + 1) & mask;
+            place(index, h, key, keySize, position);
+            slot.position = TOMBSTONE; // mantem a sondagem das chaves que ainda nao migraram
+            --oldCount;
+        }
+        if (migrated == oldSlots.size()) {
+            oldSlots = SlotArray(); // libera a tabela antiga
+        }
+    }
+
+    // Garante espaco para mais uma chave sem passar de 3/4 da capacidade,
+    // iniciando um crescimento se for preciso.
+    void reserveOne() {
+        if ((count - oldCount + tombstones + 1) * 4 <= slots.size() * 3) return;
+        if (migrating()) migrate(oldSlots.size()); // nao acontece com MIGRATION_STEP >= 4
+        size_t capacity = slots.size();
+        while ((count + 1) * 2 > capacity) capacity *= 2; // carga de no maximo 1/2 na tabela nova
+        oldSlots = std::move(slots);
+        oldMask = mask;
+        oldShift = shift;
+        migrated = 0;
+        oldCount = count;
+        slots = SlotArray(capacity);
+        mask = capacity - 1;
+        shift = shiftFor(capacity);
+        tombstones = 0;
+    }
+
+public:
+    // Construtor recebe o numero esperado de chaves (apenas o tamanho inicial: a tabela
+    // cresce conforme a carga) e a funcao de hash.
+    explicit HashTable(size_t sz = 0, Hash hash = Hash())
+        : mask(0), shift(0), oldMask(0), oldShift(0), migrated(0), oldCount(0), count(0),
+          tombstones(0), hasher(hash) {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < sz * 2) capacity *= 2;
+        slots = SlotArray(capacity);
+        mask = capacity - 1;
+        shift = shiftFor(capacity);
+    }
+
+    // Insere um novo par (chave, valor), se nao for duplicata. Uma unica sondagem
+    // encontra a chave ou a posicao livre. Retorna true se inseriu.
+    bool insert(std::string_view key, std::string_view value) {
+        if (migrating()) migrate(MIGRATION_STEP);
+        reserveOne();
+        uint64_t h = hashOf(key.data(), key.size());
+        bool found;
+        size_t index = probe(slots, mask, shift, key.data(), key.size(), h, found);
+        if (found) return false; // nao insere duplicata
+        if (migrating()) {
+            probe(oldSlots, oldMask, oldShift, key.data(), key.size(), h, found);
+            if (found) return false;
+        }
+        uint32_t position = pool.append(key.data(), static_cast<uint32_t>(key.size()),
+                                        value.data(), static_cast<uint32_t>(value.size()));
+        place(index, h, key.data(), key.size(), position);
+        ++count;
+        return true;
+    }
+
+    // Retorna o valor associado a uma chave (ou string vazia se nao existir)
+    std::string search(std::string_view key) {
+        if (migrating()) migrate(MIGRATION_STEP); // uma carga so de buscas tambem esvazia a tabela antiga
+        bool inOld;
+        const Slot* slot = find(key.data(), key.size(), hashOf(key.data(), key.size()), inOld);
+        if (slot == nullptr) return "";
+        uint32_t position = slot->position - FIRST_POSITION;
+        return std::string(pool.value(position), pool.valueSize(position));
+    }
+
+    // Indica se a chave esta na tabela (sem copiar o valor)
+    bool contains(std::string_view key) {
+        if (migrating()) migrate(MIGRATION_STEP);
+        bool inOld;
+        return find(key.data(), key.size(), hashOf(key.data(), key.size()), inOld) != nullptr;
+    }
+
+    // Remove um par (chave, valor) se a chave existir
+    bool remove(std::string_view key) {
+        if (migrating()) migrate(MIGRATION_STEP);
+        uint64_t h = hashOf(key.data(), key.size());
+        bool inOld;
+        Slot* slot = const_cast<Slot*>(find(key.data(), key.size(), h, inOld));
+        if (slot == nullptr) return false;
+        pool.markRemoved(slot->position - FIRST_POSITION);
+        if (inOld) {
+            --oldCount; // as marcas da tabela antiga somem com ela
+        } else {
+            ++tombstones;
+        }
+        slot->position = TOMBSTONE;
+        --count;
+        return true;
+    }
+
+    // Chama visit(chave, valor) para cada par, como string_views, na ordem de insercao
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        pool.forEach([&](const char* key, uint32_t keySize, const char* value, uint32_t valueSize) {
+            visit(std::string_view(key, keySize), std::string_view(value, valueSize));
+        });
+    }
+
+    // Imprime todos os pares (chave, valor) armazenados, na ordem de insercao
+    void print() const {
+        forEach([](std::string_view key, std::string_view value) { std::cout << key << " " << value << '\n'; });
+    }
+
+    // Numero de chaves presentes
+    size_t getCount() const { return count; }
+
+    // Numero de posicoes da tabela atual
+    size_t getCapacity() const { return slots.size(); }
+
+    // Bytes ocupados: as posicoes (das duas tabelas, durante a migracao) e o pool. O(1).
+    size_t getMemoryBytes() const {
+        return (slots.size() + oldSlots.size()) * sizeof(Slot) + pool.getBytes();
+    }
+
+    // Estatisticas de ocupacao. As distancias de sondagem recalculam o hash de cada
+    // chave: O(n), para diagnostico e nao para o caminho quente.
+    HashTableStats getStats() const {
+        HashTableStats stats;
+        stats.count = count;
+        stats.capacity = slots.size();
+        stats.tombstones = tombstones;
+        stats.loadFactor = static_cast<double>(count - oldCount) / slots.size();
+        stats.longestProbe = 0;
+        stats.pendingMigration = oldCount;
+        stats.poolBytes = pool.getBytes();
+        double total = 0;
+        const SlotArray* tables[] = {&slots, &oldSlots};
+        const size_t masks[] = {mask, oldMask};
+        const unsigned shifts[] = {shift, oldShift};
+        for (int t = 0; t < 2; ++t) {
+            const SlotArray& table = *tables[t];
+            for (size_t i = 0; i < table.size(); ++i) {
+                if (table[i].position < FIRST_POSITION) continue;
+                uint32_t position = table[i].position - FIRST_POSITION;
+                size_t home = hashOf(pool.key(position), pool.keySize(position)) >> shifts[t];
+                size_t distance = (i - home) & masks[t];
+                total += distance;
+                if (distance > stats.longestProbe) stats.longestProbe = distance;
+            }
+        }
+        stats.averageProbe = count == 0 ? 0.0 : total / count;
+        return stats;
+    }
+};
+
+#endif // HASH_TABLE_H
@@ -0,0 +1,255 @@
+#ifndef PARALLEL_DEDUP_H
+#define PARALLEL_DEDUP_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "csv_reader.h"
+#include "hash_table.h"
+
+// Arquivo inteiro mapeado em memoria. O mapeamento e privado e gravavel: o CsvReader
+// desfaz as aspas no proprio texto, e essas escritas ficam so na copia do processo
+// (o arquivo em disco nao muda).
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : data(nullptr), size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("MappedFile: nao foi possivel abrir " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("MappedFile: nao foi possivel ler o tamanho de " + path);
+        }
+        size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            void* mapa = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mapa == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("MappedFile: nao foi possivel mapear " + path);
+            }
+            data = static_cast<char*>(mapa);
+            madvise(data, size, MADV_SEQUENTIAL);
+        }
+        close(fd); // o mapeamento continua valido sem o descritor
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) munmap(data, size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+private:
+    char* data;
+    size_t size;
+};
+
+// Resultado da eliminacao de duplicatas em paralelo: uma HashTable por particao, e cada
+// chave fica na particao escolhida pelo seu hash. Guarda tambem a ordem da primeira
+// ocorrencia das chaves no arquivo (de qual particao veio cada uma), para que print()
+// produza exatamente a saida da versao sequencial.
+template <typename Hash = StringHash>
+class PartitionedHashTable {
+public:
+    PartitionedHashTable(size_t partitions, Hash hash = Hash()) : hasher(hash) {
+        if (partitions == 0 || partitions > 65535) {
+            throw std::invalid_argument("PartitionedHashTable: numero de particoes deve estar entre 1 e 65535.");
+        }
+        tables.reserve(partitions);
+        for (size_t p = 0; p < partitions; ++p) tables.emplace_back(0, hash);
+    }
+
+    // Particao de uma chave. Usa os bits 32 em diante do hash: a HashTable escolhe a
+    // posicao pelos bits mais altos e usa os 32 baixos como etiqueta, entao a escolha da
+    // particao nao concentra as chaves de uma particao em parte da tabela dela.
+    size_t partitionOf(uint64_t h) const { return (h >> 32) % tables.size(); }
+    size_t partitionOf(std::string_view key) const { return partitionOf(hasher(key)); }
+
+    bool contains(std::string_view key) { return tables[partitionOf(key)].contains(key); }
+    std::string search(std::string_view key) { return tables[partitionOf(key)].search(key); }
+
+    // Numero de chaves presentes
+    size_t getCount() const { return order.size(); }
+
+    size_t getPartitions() const { return tables.size(); }
+    const HashTable<Hash>& getPartition(size_t p) const { return tables[p]; }
+
+    // Chama visit(chave, valor) para cada par, na ordem da primeira ocorrencia no arquivo
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        std::vector<std::vector<std::pair<std::string_view, std::string_view>>> pares(tables.size());
+        for (size_t p = 0; p < tables.size(); ++p) {
+            pares[p].reserve(tables[p].getCount());
+            tables[p].forEach([&](std::string_view key, std::string_view value) { pares[p].emplace_back(key, value); });
+        }
+        std::vector<size_t> proximo(tables.size(), 0);
+        for (uint16_t p : order) {
+            const std::pair<std::string_view, std::string_view>& par = pares[p][proximo[p]++];
+            visit(par.first, par.second);
+        }
+    }
+
+    // Imprime todos os pares (chave, valor), na ordem da primeira ocorrencia no arquivo
+    void print() const {
+        forEach([](std::string_view key, std::string_view value) { std::cout << key << " " << value << '\n'; });
+    }
+
+private:
+    template <typename H>
+    friend PartitionedHashTable<H> eliminateDuplicateParallel(const std::string& path, size_t threads, H hash);
+
+    Hash hasher;
+    std::vector<HashTable<Hash>> tables;
+    std::vector<uint16_t> order; // particao de cada chave, na ordem da primeira ocorrencia
+};
+
+// Inicio do primeiro registro depois de 'p': a posicao seguinte a primeira quebra de linha
+// fora de aspas, sabendo se 'p' esta dentro de um campo entre aspas. Como no CsvReader,
+// cada '"' alterna o estado (aspas em dobro alternam duas vezes).
+inline char* nextRecordStart(char* p, char* fim, bool inQuotes) {
+    for (; p < fim; ++p) {
+        if (*p == '"') {
+            inQuotes = !inQuotes;
+        } else if (*p == '\n' && !inQuotes) {
+            return p + 1;
+        }
+    }
+    return fim;
+}
+
+// Elimina as duplicatas de um CSV (chave na 1a coluna, valor na 2a) com 'threads' threads,
+// mantendo a primeira ocorrencia de cada chave, como a versao sequencial:
+//  1. o arquivo e mapeado e dividido em 'threads' trechos que comecam no inicio de um
+//     registro; cada thread le o seu trecho e separa os registros por particao (hash da
+//     chave), guardando so string_views para o arquivo mapeado;
+//  2. cada thread fica com uma particao e insere na sua HashTable os registros dela,
+//     trecho a trecho, na ordem do arquivo; nenhuma tabela e compartilhada, entao nao
+//     ha travas. Vence a primeira ocorrencia, porque os trechos sao visitados em ordem;
+//  3. as listas de vencedores de cada particao (em ordem de posicao no arquivo) sao
+//     intercaladas para registrar a ordem global das chaves.
+// Para cortar os trechos so entre registros (campos entre aspas podem ter quebras de
+// linha), cada thread conta as aspas de uma fatia do arquivo; a paridade acumulada diz
+// se o corte caiu dentro de aspas, e o trecho comeca na primeira quebra de linha fora
+// delas. Os registros sao exatamente os da versao sequencial.
+template <typename Hash = StringHash>
+PartitionedHashTable<Hash> eliminateDuplicateParallel(const std::string& path, size_t threads, Hash hash = Hash()) {
+    if (threads == 0) threads = 1;
+    PartitionedHashTable<Hash> result(threads, hash);
+    MappedFile file(path);
+    if (file.getSize() == 0) return result;
+    char* inicio = file.getData();
+    char* fim = inicio + file.getSize();
+
+    inicio = nextRecordStart(inicio, fim, false); // pula o cabecalho
+
+    struct Entry {
+        const char* key;
+        const char* value;
+        uint32_t keySize;
+        uint32_t valueSize;
+    };
+    size_t particoes = threads;
+    std::vector<std::vector<Entry>> entradas(threads * particoes); // [trecho * particoes + particao]
+    std::vector<std::vector<const char*>> vencedores(particoes);  // chaves inseridas por particao
+    std::vector<std::exception_ptr> erros(threads);
+
+    // Executa fase(t) em 'threads' threads e repassa a primeira excecao
+    auto executar = [&](auto fase) {
+        std::vector<std::thread> trabalhadores;
+        for (size_t t = 0; t < threads; ++t) {
+            trabalhadores.emplace_back([&, t]() {
+                try {
+                    fase(t);
+                } catch (...) {
+                    erros[t] = std::current_exception();
+                }
+            });
+        }
+        for (std::thread& trabalhador : trabalhadores) trabalhador.join();
+        for (std::exception_ptr& erro : erros) {
+            if (erro) std::rethrow_exception(erro);
+        }
+    };
+
+    // Limites dos trechos, sempre no inicio de um registro. O trecho t comeca no primeiro
+    // registro depois de inicio + t * passo; como os pontos de partida crescem com t, os
+    // limites tambem crescem (trechos vazios sao possiveis).
+    std::vector<char*> limites(threads + 1, fim);
+    limites[0] = inicio;
+    if (threads > 1) {
+        size_t passo = static_cast<size_t>(fim - inicio) / threads;
+        std::vector<size_t> aspas(threads, 0); // aspas em [inicio + t * passo, inicio + (t + 1) * passo)
+        executar([&](size_t t) {
+            char* a = inicio + t * passo;
+            char* b = t + 1 < threads ? a + passo : fim;
+            aspas[t] = static_cast<size_t>(std::count(a, b, '"'));
+        });
+        bool inQuotes = false;
+        for (size_t t = 1; t < threads; ++t) {
+            inQuotes ^= (aspas[t - 1] & 1) != 0;
+            limites[t] = nextRecordStart(inicio + t * passo, fim, inQuotes);
+        }
+    }
+
+    executar([&](size_t t) {
+        CsvReader reader(limites[t], limites[t + 1]);
+        std::vector<std::string_view> fields;
+        while (reader.next(fields)) {
+            std::string_view value = fields.size() > 1 ? fields[1] : std::string_view();
+            Entry entrada = {fields[0].data(), value.data(), static_cast<uint32_t>(fields[0].size()),
+                             static_cast<uint32_t>(value.size())};
+            entradas[t * particoes + result.partitionOf(fields[0])].push_back(entrada);
+        }
+    });
+
+    executar([&](size_t p) {
+        HashTable<Hash>& table = result.tables[p];
+        for (size_t t = 0; t < threads; ++t) {
+            std::vector<Entry>& lista = entradas[t * particoes + p];
+            for (const Entry& entrada : lista) {
+                if (table.insert(std::string_view(entrada.key, entrada.keySize),
+                                 std::string_view(entrada.value, entrada.valueSize))) {
+                    vencedores[p].push_back(entrada.key);
+                }
+            }
+            std::vector<Entry>().swap(lista); // libera a lista ja consumida
+        }
+    });
+
+    // Intercala os vencedores pela posicao no arquivo (a chave mais a esquerda primeiro)
+    typedef std::pair<const char*, size_t> Cabeca; // (chave, particao)
+    std::priority_queue<Cabeca, std::vector<Cabeca>, std::greater<Cabeca>> fila;
+    std::vector<size_t> proximo(particoes, 0);
+    size_t total = 0;
+    for (size_t p = 0; p < particoes; ++p) {
+        total += vencedores[p].size();
+        if (!vencedores[p].empty()) fila.push(Cabeca(vencedores[p][0], p));
+    }
+    result.order.reserve(total);
+    while (!fila.empty()) {
+        size_t p = fila.top().second;
+        fila.pop();
+        result.order.push_back(static_cast<uint16_t>(p));
+        if (++proximo[p] < vencedores[p].size()) fila.push(Cabeca(vencedores[p][proximo[p]], p));
+    }
+    return result;
+}
+
+#endif // PARALLEL_DEDUP_H
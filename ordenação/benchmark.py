@@ -0,0 +1,69 @@
+import filecmp
+import os
+import random
+import shutil
+import subprocess
+import sys
+import time
+from contextlib import redirect_stdout
+
+from gera_csv import gerar_csv_grande
+from ordena_externa import ordenacao_externa
+
+
+def _mede(funcao):
+    """Executa a função e retorna o tempo decorrido em segundos."""
+    inicio = time.perf_counter()
+    funcao()
+    return time.perf_counter() - inicio
+
+
+def benchmark(executavel, num_linhas, tamanho_buffer_mb, pasta):
+    """
+    Compara ordena_externa.py com a versão em C++ sobre um CSV gerado por gera_csv.py,
+    nas duas ordens, e confere se os dois arquivos ordenados são idênticos.
+    """
+    os.makedirs(pasta, exist_ok=True)
+    entrada_py = os.path.join(pasta, 'bench_py.csv')
+    entrada_cpp = os.path.join(pasta, 'bench_cpp.csv')
+
+    random.seed(42)
+    with open(os.devnull, 'w') as nulo, redirect_stdout(nulo):
+        gerar_csv_grande(entrada_py, num_linhas)
+    shutil.copyfile(entrada_py, entrada_cpp)
+    tamanho_mb = os.path.getsize(entrada_py) / (1024 * 1024)
+    print(f"=== Ordenação externa: {num_linhas} linhas ({tamanho_mb:.1f} MB), "
+          f"buffer de {tamanho_buffer_mb} MB ===")
+
+    iguais = True
+    for ordem in ('ascendente', 'descendente'):
+        with open(os.devnull, 'w') as nulo, redirect_stdout(nulo):
+            tempo_py = _mede(lambda: ordenacao_externa(
+                entrada_py, 'id_aluno', ordem, tamanho_buffer_mb))
+        tempo_cpp = _mede(lambda: subprocess.run(
+            [executavel, entrada_cpp, 'id_aluno', ordem, str(tamanho_buffer_mb)],
+            check=True, stdout=subprocess.DEVNULL))
+
+        saida_py = os.path.join(pasta, 'bench_py_ordenado.csv')
+        saida_cpp = os.path.join(pasta, 'bench_cpp_ordenado.csv')
+        identicos = filecmp.cmp(saida_py, saida_cpp, shallow=False)
+        iguais = iguais and identicos
+        print(f"  {ordem}: Python {tempo_py:.2f} s ({tamanho_mb / tempo_py:.1f} MB/s), "
+              f"C++ {tempo_cpp:.2f} s ({tamanho_mb / tempo_cpp:.1f} MB/s), "
+              f"{tempo_py / tempo_cpp:.1f}x; saídas idênticas: {'sim' if identicos else 'NÃO'}")
+        os.remove(saida_py)
+        os.remove(saida_cpp)
+
+    os.remove(entrada_py)
+    os.remove(entrada_cpp)
+    return iguais
+
+
+if __name__ == '__main__':
+    # Uso: python3 benchmark.py <executável C++> [num_linhas] [tamanho_buffer_mb] [pasta]
+    EXECUTAVEL = sys.argv[1] if len(sys.argv) > 1 else 'build/ordena_externa'
+    NUM_LINHAS = int(sys.argv[2]) if len(sys.argv) > 2 else 1_000_000
+    TAMANHO_BUFFER_MB = int(sys.argv[3]) if len(sys.argv) > 3 else 50
+    PASTA = sys.argv[4] if len(sys.argv) > 4 else '.'
+
+    sys.exit(0 if benchmark(EXECUTAVEL, NUM_LINHAS, TAMANHO_BUFFER_MB, PASTA) else 1)
@@ -0,0 +1,858 @@
+// Ordenação externa (merge sort) de arquivos CSV, versão nativa de ordena_externa.py.
+//
+// Mesmo contrato da função ordenacao_externa: arquivo de entrada, coluna chave (nome ou
+// índice), ordem 'ascendente' ou 'descendente' e o tamanho do buffer em MB; o resultado
+// vai para <entrada>_ordenado<extensão>. Como na versão em Python, chaves que são números
+// (inteiros ou reais) são comparadas como números, e as demais como texto. Chaves NaN
+// ("nan") ficam depois de todos os números e são iguais entre si.
+//
+// Fase 1: o arquivo é lido em blocos grandes para um buffer do tamanho pedido; os registros
+// ficam onde foram lidos, e só um índice (chave já convertida e posição da linha) é
+// ordenado. Cada run é gravado em binário: a chave convertida e a linha original, então a
+// fase 2 não volta a interpretar CSV nem a converter números.
+// Fase 2: os runs são intercalados com uma árvore de perdedores (log2 k comparações por
+// registro, contra cerca de 2 log2 k de um heap). Com mais de MAXIMO_RUNS_POR_MESCLA
+// runs, grupos de runs consecutivos são intercalados antes em runs maiores.
+//
+// A ordenação é estável nas duas ordens: registros com chaves iguais saem na ordem em que
+// aparecem na entrada. As linhas são copiadas sem alteração (inclusive as aspas), com o
+// terminador de linha da entrada ("\n" ou "\r\n").
+//
+// Uso: ./ordena_externa <entrada.csv> <coluna> [ascendente|descendente] [tamanho_buffer_mb]
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t BLOCO_LEITURA = 8 << 20;          // leitura da entrada em blocos de 8 MB
+const size_t BUFFER_SAIDA = 8 << 20;           // escrita dos runs e do arquivo final
+const size_t BUFFER_MINIMO_RUN = 256 << 10;    // buffer mínimo de leitura de cada run na mescla
+const size_t MAXIMO_RUNS_POR_MESCLA = 256;     // limita arquivos abertos e buffers por mescla
+
+// Tipos de chave, na ordem em que aparecem na ordenação ascendente: números, depois NaN
+// (todos iguais entre si) e por fim textos. Em Python, misturar números e textos na mesma
+// coluna é um erro, e NaN não tem lugar definido na ordem.
+enum TipoChave : uint8_t { INTEIRO = 0, REAL = 1, NAO_NUMERO = 2, TEXTO = 3 };
+
+// Chave convertida de um registro. Textos apontam para fora da estrutura.
+struct Chave {
+    uint8_t tipo;
+    union {
+        int64_t inteiro;
+        double real;
+    };
+    const char* texto;
+    uint32_t tamanho;
+};
+
+// Compara duas chaves: negativo, zero ou positivo. Inteiros e reais são comparados como
+// long double, que representa exatamente qualquer int64_t e qualquer double.
+int comparaChaves(const Chave& a, const Chave& b) {
+    if (a.tipo == TEXTO || b.tipo == TEXTO) {
+        if (a.tipo != b.tipo) {
+            return a.tipo == TEXTO ? 1 : -1;
+        }
+        // Comparar bytes de UTF-8 dá a mesma ordem que comparar os pontos de código (Python)
+        int c = std::memcmp(a.texto, b.texto, std::min(a.tamanho, b.tamanho));
+        if (c != 0) {
+            return c;
+        }
+        return a.tamanho < b.tamanho ? -1 : (a.tamanho > b.tamanho ? 1 : 0);
+    }
+    if (a.tipo == NAO_NUMERO || b.tipo == NAO_NUMERO) {
+        // NaN não é menor nem maior que nenhum número: sem um lugar próprio, a ordem deixaria
+        // de ser estrita e fraca (requisito de std::sort e da árvore de perdedores)
+        return a.tipo == b.tipo ? 0 : (a.tipo == NAO_NUMERO ? 1 : -1);
+    }
+    if (a.tipo == INTEIRO && b.tipo == INTEIRO) {
+        return a.inteiro < b.inteiro ? -1 : (a.inteiro > b.inteiro ? 1 : 0);
+    }
+    long double x = a.tipo == INTEIRO ? static_cast<long double>(a.inteiro) : a.real;
+    long double y = b.tipo == INTEIRO ? static_cast<long double>(b.inteiro) : b.real;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+bool ehEspaco(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Equivalente a _tenta_converter_para_numero: int(valor), senão float(valor), senão o
+// próprio texto. Aceita espaços nas pontas, sinal e '_' entre dígitos nos inteiros.
+// Inteiros fora do int64_t viram reais.
+void converteChave(const char* texto, size_t tamanho, Chave& chave) {
+    chave.tipo = TEXTO;
+    chave.texto = texto;
+    chave.tamanho = static_cast<uint32_t>(tamanho);
+    const char* inicio = texto;
+    const char* fim = texto + tamanho;
+    while (inicio < fim && ehEspaco(*inicio)) ++inicio;
+    while (fim > inicio && ehEspaco(fim[-1])) --fim;
+    if (inicio == fim) {
+        return;
+    }
+
+    // Inteiro
+    const char* p = inicio;
+    bool negativo = false;
+    if (*p == '+' || *p == '-') {
+        negativo = *p == '-';
+        ++p;
+    }
+    uint64_t valor = 0;
+    bool transbordou = false;
+    bool inteiro = p < fim && *p >= '0' && *p <= '9';
+    for (const char* q = p; inteiro && q < fim; ++q) {
+        if (*q == '_' && q > p && q + 1 < fim && q[-1] != '_' && q[1] >= '0' && q[1] <= '9') {
+            continue;
+        }
+        if (*q < '0' || *q > '9') {
+            inteiro = false;
+        } else if (valor > (UINT64_MAX - 9) / 10) {
+            transbordou = true;
+        } else {
+            valor = valor * 10 + static_cast<uint64_t>(*q - '0');
+        }
+    }
+    const uint64_t LIMITE = static_cast<uint64_t>(INT64_MAX) + (negativo ? 1 : 0);
+    if (inteiro && !transbordou && valor <= LIMITE) {
+        chave.tipo = INTEIRO;
+        chave.inteiro = negativo ? static_cast<int64_t>(0 - valor) : static_cast<int64_t>(valor);
+        return;
+    }
+
+    // Real (strtod aceita hexadecimais, que o float do Python recusa)
+    char copia[128];
+    size_t n = static_cast<size_t>(fim - inicio);
+    if (n >= sizeof(copia) || std::memchr(inicio, 'x', n) != nullptr || std::memchr(inicio, 'X', n) != nullptr) {
+        return;
+    }
+    std::memcpy(copia, inicio, n);
+    copia[n] = '\0';
+    char* resto = nullptr;
+    double real = std::strtod(copia, &resto);
+    if (resto == copia + n) {
+        chave.tipo = real != real ? NAO_NUMERO : REAL;
+        chave.real = real;
+    }
+}
+
+// Escrita em um arquivo com buffer próprio e grande.
+class Escritor {
+public:
+    Escritor(const std::string& caminho, size_t tamanhoBuffer)
+        : arquivo(std::fopen(caminho.c_str(), "wb")), caminho(caminho), buffer(tamanhoBuffer), usados(0) {
+        if (arquivo == nullptr) {
+            throw std::runtime_error("não foi possível criar " + caminho);
+        }
+    }
+
+    ~Escritor() {
+        if (arquivo != nullptr) {
+            std::fclose(arquivo);
+        }
+    }
+
+    Escritor(const Escritor&) = delete;
+    Escritor& operator=(const Escritor&) = delete;
+
+    void escrever(const void* dados, size_t tamanho) {
+        if (usados + tamanho > buffer.size()) {
+            descarregar();
+            if (tamanho > buffer.size()) {
+                gravar(dados, tamanho);
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + usados, dados, tamanho);
+        usados += tamanho;
+    }
+
+    // Grava o que falta e fecha o arquivo, lançando exceção se houver erro de escrita.
+    void fechar() {
+        descarregar();
+        std::FILE* f = arquivo;
+        arquivo = nullptr;
+        if (std::fclose(f) != 0) {
+            throw std::runtime_error("erro ao fechar " + caminho);
+        }
+    }
+
+private:
+    std::FILE* arquivo;
+    std::string caminho;
+    std::vector<char> buffer;
+    size_t usados;
+
+    void gravar(const void* dados, size_t tamanho) {
+        if (std::fwrite(dados, 1, tamanho, arquivo) != tamanho) {
+            throw std::runtime_error("erro de escrita em " + caminho);
+        }
+    }
+
+    void descarregar() {
+        gravar(buffer.data(), usados);
+        usados = 0;
+    }
+};
+
+// Registro de um run em binário: este cabeçalho, os bytes da chave (só para textos) e
+// a linha original, sem o terminador.
+struct CabecalhoRegistro {
+    uint32_t tamanhoLinha;
+    uint32_t tamanhoChave;  // bytes da chave que seguem o cabeçalho (0 para números)
+    uint8_t tipo;
+    uint8_t reservado[7];
+    uint64_t valor;         // inteiro ou bits do real
+};
+
+void gravaRegistro(Escritor& saida, const Chave& chave, const char* linha, uint32_t tamanhoLinha) {
+    CabecalhoRegistro cabecalho;
+    std::memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.tamanhoLinha = tamanhoLinha;
+    cabecalho.tipo = chave.tipo;
+    if (chave.tipo == TEXTO) {
+        cabecalho.tamanhoChave = chave.tamanho;
+    } else if (chave.tipo == INTEIRO) {
+        std::memcpy(&cabecalho.valor, &chave.inteiro, sizeof(cabecalho.valor));
+    } else {
+        std::memcpy(&cabecalho.valor, &chave.real, sizeof(cabecalho.valor));
+    }
+    saida.escrever(&cabecalho, sizeof(cabecalho));
+    if (chave.tipo == TEXTO) {
+        saida.escrever(chave.texto, chave.tamanho);
+    }
+    saida.escrever(linha, tamanhoLinha);
+}
+
+// Leitura sequencial de um run binário. A chave e a linha do registro atual apontam para
+// o buffer e valem até a próxima chamada de avancar().
+class LeitorRun {
+public:
+    LeitorRun(const std::string& caminho, size_t tamanhoBuffer)
+        : arquivo(std::fopen(caminho.c_str(), "rb")), caminho(caminho), buffer(tamanhoBuffer),
+          inicio(0), fim(0), terminou(false) {
+        if (arquivo == nullptr) {
+            throw std::runtime_error("não foi possível abrir o run " + caminho);
+        }
+        posix_fadvise(fileno(arquivo), 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    ~LeitorRun() { std::fclose(arquivo); }
+
+    LeitorRun(const LeitorRun&) = delete;
+    LeitorRun& operator=(const LeitorRun&) = delete;
+
+    // Lê o próximo registro; false no fim do run.
+    bool avancar() {
+        if (!disponivel(sizeof(CabecalhoRegistro))) {
+            if (fim != inicio) {
+                throw std::runtime_error("run truncado: " + caminho);
+            }
+            return false;
+        }
+        CabecalhoRegistro cabecalho;
+        std::memcpy(&cabecalho, buffer.data() + inicio, sizeof(cabecalho));
+        size_t total = sizeof(cabecalho) + cabecalho.tamanhoChave + cabecalho.tamanhoLinha;
+        if (!disponivel(total)) {
+            throw std::runtime_error("run truncado: " + caminho);
+        }
+        const char* dados = buffer.data() + inicio + sizeof(cabecalho);
+        chave.tipo = cabecalho.tipo;
+        chave.texto = dados;
+        chave.tamanho = cabecalho.tamanhoChave;
+        if (cabecalho.tipo == INTEIRO) {
+            std::memcpy(&chave.inteiro, &cabecalho.valor, sizeof(chave.inteiro));
+        } else if (cabecalho.tipo == REAL) {
+            std::memcpy(&chave.real, &cabecalho.valor, sizeof(chave.real));
+        }
+        linha = dados + cabecalho.tamanhoChave;
+        tamanhoLinha = cabecalho.tamanhoLinha;
+        inicio += total;
+        return true;
+    }
+
+    Chave chave;
+    const char* linha;
+    uint32_t tamanhoLinha;
+
+private:
+    std::FILE* arquivo;
+    std::string caminho;
+    std::vector<char> buffer;
+    size_t inicio;  // próximo byte não consumido
+    size_t fim;     // fim dos bytes válidos
+    bool terminou;
+
+    // Garante 'n' bytes contíguos a partir de 'inicio', trazendo o restante para o começo
+    // do buffer (e aumentando-o, para registros maiores que ele).
+    bool disponivel(size_t n) {
+        if (fim - inicio >= n) {
+            return true;
+        }
+        std::memmove(buffer.data(), buffer.data() + inicio, fim - inicio);
+        fim -= inicio;
+        inicio = 0;
+        if (n > buffer.size()) {
+            buffer.resize(n);
+        }
+        while (fim < n && !terminou) {
+            size_t lidos = std::fread(buffer.data() + fim, 1, buffer.size() - fim, arquivo);
+            if (lidos == 0) {
+                if (std::ferror(arquivo)) {
+                    throw std::runtime_error("erro de leitura em " + caminho);
+                }
+                terminou = true;
+            }
+            fim += lidos;
+        }
+        return fim >= n;
+    }
+};
+
+// Árvore de perdedores sobre k runs: cada nó interno guarda o run que perdeu a disputa
+// naquele nó, e perdedores[0] guarda o vencedor. Depois de consumir o vencedor, só o
+// caminho da folha dele até a raiz é refeito, com uma comparação por nível.
+class ArvorePerdedores {
+public:
+    ArvorePerdedores(std::vector<std::unique_ptr<LeitorRun>>& runs, bool descendente)
+        : runs(runs), ativos(runs.size(), true), perdedores(runs.size()), descendente(descendente) {
+        size_t k = runs.size();
+        for (size_t i = 0; i < k; ++i) {
+            ativos[i] = runs[i]->avancar();
+        }
+        // Folhas nas posições k..2k-1; vencedores[n] é o vencedor da subárvore de n
+        std::vector<size_t> vencedores(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            vencedores[k + i] = i;
+        }
+        for (size_t n = k - 1; n >= 1; --n) {
+            size_t a = vencedores[2 * n];
+            size_t b = vencedores[2 * n + 1];
+            bool aVence = vence(a, b);
+            vencedores[n] = aVence ? a : b;
+            perdedores[n] = aVence ? b : a;
+        }
+        perdedores[0] = k > 1 ? vencedores[1] : 0;
+    }
+
+    bool vazia() const { return !ativos[perdedores[0]]; }
+    LeitorRun& vencedor() { return *runs[perdedores[0]]; }
+
+    // Consome o registro do vencedor e escolhe o próximo.
+    void avancar() {
+        size_t vencedorAtual = perdedores[0];
+        ativos[vencedorAtual] = runs[vencedorAtual]->avancar();
+        for (size_t n = (runs.size() + vencedorAtual) / 2; n >= 1; n /= 2) {
+            if (vence(perdedores[n], vencedorAtual)) {
+                std::swap(perdedores[n], vencedorAtual);
+            }
+        }
+        perdedores[0] = vencedorAtual;
+    }
+
+private:
+    std::vector<std::unique_ptr<LeitorRun>>& runs;
+    std::vector<bool> ativos;        // false quando o run acabou (perde de todos)
+    std::vector<size_t> perdedores;
+    bool descendente;
+
+    // O run 'a' sai antes do 'b'? Em caso de empate, o run anterior (estabilidade).
+    bool vence(size_t a, size_t b) const {
+        if (!ativos[a] || !ativos[b]) {
+            return ativos[a] || (!ativos[b] && a < b);
+        }
+        int c = comparaChaves(runs[a]->chave, runs[b]->chave);
+        if (descendente) {
+            c = -c;
+        }
+        return c < 0 || (c == 0 && a < b);
+    }
+};
+
+// Diretório temporário para os runs (em $TMPDIR, ou /tmp). O destrutor apaga os runs
+// que restarem e o diretório, também quando uma exceção interrompe a ordenação.
+class PastaTemporaria {
+public:
+    PastaTemporaria() : proximo(0) {
+        const char* base = std::getenv("TMPDIR");
+        std::string modelo = std::string(base != nullptr && *base != '\0' ? base : "/tmp") + "/ordenacao_externa_XXXXXX";
+        std::vector<char> nome(modelo.begin(), modelo.end());
+        nome.push_back('\0');
+        if (mkdtemp(nome.data()) == nullptr) {
+            throw std::runtime_error("não foi possível criar a pasta temporária " + modelo);
+        }
+        caminho = nome.data();
+    }
+
+    ~PastaTemporaria() {
+        for (const std::string& arquivo : arquivos) {
+            std::remove(arquivo.c_str());
+        }
+        rmdir(caminho.c_str());
+    }
+
+    PastaTemporaria(const PastaTemporaria&) = delete;
+    PastaTemporaria& operator=(const PastaTemporaria&) = delete;
+
+    std::string novoRun() {
+        arquivos.push_back(caminho + "/run_" + std::to_string(proximo++) + ".bin");
+        return arquivos.back();
+    }
+
+    void apagar(const std::string& arquivo) {
+        std::remove(arquivo.c_str());
+        arquivos.erase(std::find(arquivos.begin(), arquivos.end(), arquivo));
+    }
+
+    const std::string& getCaminho() const { return caminho; }
+
+private:
+    std::string caminho;
+    std::vector<std::string> arquivos;
+    size_t proximo;
+};
+
+// Resultado da leitura de um registro CSV em [inicio, fim).
+struct RegistroCsv {
+    const char* proximo;       // início do registro seguinte
+    size_t tamanhoLinha;       // linha sem o terminador
+    size_t numeroCampos;
+    const char* chave;         // campo da coluna chave, ainda com aspas, se houver
+    size_t tamanhoChave;
+    bool chaveComAspas;
+};
+
+// Lê um registro (RFC 4180: campos entre aspas podem ter separadores, aspas dobradas e
+// quebras de linha). Retorna false se o registro não termina antes de 'fim' e o arquivo
+// ainda não acabou ('fimDoArquivo' == false).
+bool leRegistro(const char* inicio, const char* fim, bool fimDoArquivo, size_t coluna, RegistroCsv& registro) {
+    const char* p = inicio;
+    size_t campo = 0;
+    registro.chave = nullptr;
+    registro.tamanhoChave = 0;
+    registro.chaveComAspas = false;
+    while (true) {
+        const char* inicioCampo = p;
+        bool aspas = p < fim && *p == '"';
+        if (aspas) {
+            ++p;
+            while (true) {
+                p = static_cast<const char*>(std::memchr(p, '"', fim - p));
+                if (p == nullptr) {
+                    if (!fimDoArquivo) {
+                        return false;
+                    }
+                    p = fim;  // aspas sem fechamento: o campo vai até o fim do arquivo
+                    break;
+                }
+                if (p + 1 < fim && p[1] == '"') {
+                    p += 2;
+                } else if (p + 1 == fim && !fimDoArquivo) {
+                    return false;  // não dá para saber se a aspa é dobrada
+                } else {
+                    ++p;
+                    break;
+                }
+            }
+        }
+        while (p < fim && *p != ',' && *p != '\n') {
+            ++p;
+        }
+        if (campo == coluna) {
+            registro.chave = inicioCampo;
+            registro.tamanhoChave = static_cast<size_t>(p - inicioCampo);
+            registro.chaveComAspas = aspas;
+        }
+        ++campo;
+        if (p == fim) {
+            if (!fimDoArquivo) {
+                return false;
+            }
+            registro.proximo = fim;  // última linha sem quebra de linha
+            break;
+        }
+        if (*p == '\n') {
+            registro.proximo = p + 1;
+            break;
+        }
+        ++p;  // separador
+    }
+    registro.tamanhoLinha = static_cast<size_t>(p - inicio);
+    if (registro.tamanhoLinha > 0 && inicio[registro.tamanhoLinha - 1] == '\r') {
+        --registro.tamanhoLinha;
+        if (campo - 1 == coluna && registro.chave != nullptr && registro.tamanhoChave > 0 &&
+            registro.chave[registro.tamanhoChave - 1] == '\r') {
+            --registro.tamanhoChave;
+        }
+    }
+    registro.numeroCampos = campo;
+    return true;
+}
+
+// Texto de um campo: sem as aspas externas e com as aspas dobradas desfeitas.
+std::string textoDoCampo(const char* campo, size_t tamanho, bool aspas) {
+    if (!aspas) {
+        return std::string(campo, tamanho);
+    }
+    std::string texto;
+    size_t i = 1;
+    while (i < tamanho) {
+        if (campo[i] == '"') {
+            if (i + 1 < tamanho && campo[i + 1] == '"') {
+                texto += '"';
+                i += 2;
+                continue;
+            }
+            ++i;  // aspa de fechamento; o que vier depois faz parte do campo
+            continue;
+        }
+        texto += campo[i++];
+    }
+    return texto;
+}
+
+// Entrada do índice de um run na memória. As posições são relativas ao buffer de dados
+// (ou, para chaves entre aspas, ao buffer de chaves desfeitas), para que os textos só
+// sejam resolvidos na hora de ordenar.
+struct EntradaIndice {
+    union {
+        int64_t inteiro;
+        double real;
+    };
+    uint64_t linha;         // posição da linha no buffer de dados (também desempata)
+    uint64_t chave;         // posição do texto da chave
+    uint32_t tamanhoLinha;
+    uint32_t tamanhoChave;
+    uint8_t tipo;
+    bool chaveSeparada;     // o texto da chave está no buffer de chaves desfeitas
+};
+
+class OrdenacaoExterna {
+public:
+    OrdenacaoExterna(const std::string& entrada, const std::string& coluna, bool descendente, size_t bufferMb)
+        : entrada(entrada), coluna(coluna), descendente(descendente), orcamento(bufferMb * 1024 * 1024),
+          indiceChave(0), linhas(0) {}
+
+    // Executa as duas fases. Retorna false se a entrada não tem registros.
+    bool ordenar(const std::string& saida) {
+        PastaTemporaria pasta;
+        std::cout << "Pasta temporária criada em: " << pasta.getCaminho() << std::endl;
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        std::cout << "--- Fase 1: Dividindo o arquivo em 'runs' ordenados ---" << std::endl;
+        std::vector<std::string> runs = divideEmRuns(pasta);
+        std::cout << "Total de " << runs.size() << " runs criados (" << linhas << " registros, "
+                  << segundosDesde(inicio) << " s)." << std::endl;
+        if (runs.empty()) {
+            return false;
+        }
+
+        inicio = std::chrono::steady_clock::now();
+        std::cout << "\n--- Fase 2: Mesclando os 'runs' ---" << std::endl;
+        while (runs.size() > MAXIMO_RUNS_POR_MESCLA) {
+            std::vector<std::string> maiores;
+            for (size_t i = 0; i < runs.size(); i += MAXIMO_RUNS_POR_MESCLA) {
+                std::vector<std::string> grupo(runs.begin() + i,
+                                               runs.begin() + std::min(runs.size(), i + MAXIMO_RUNS_POR_MESCLA));
+                maiores.push_back(pasta.novoRun());
+                mescla(grupo, maiores.back(), false);
+                for (const std::string& run : grupo) {
+                    pasta.apagar(run);
+                }
+            }
+            std::cout << "  " << runs.size() << " runs intercalados em " << maiores.size() << std::endl;
+            runs.swap(maiores);
+        }
+        std::cout << "  Mesclando " << runs.size() << " runs..." << std::endl;
+        mescla(runs, saida, true);
+        std::cout << "Mescla concluída em " << segundosDesde(inicio) << " s." << std::endl;
+        return true;
+    }
+
+private:
+    std::string entrada;
+    std::string coluna;
+    bool descendente;
+    size_t orcamento;        // bytes para os dados e o índice de um run
+    size_t indiceChave;
+    size_t linhas;
+    std::string cabecalho;   // linha de cabeçalho, sem o terminador
+    std::string terminador;  // "\n" ou "\r\n", como na entrada
+
+    static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Acha a coluna chave no cabeçalho: pelo nome ou, se nenhum campo tiver esse nome e
+    // ele for um número, pelo índice.
+    void defineColuna() {
+        std::vector<std::string> nomes;
+        const char* fim = cabecalho.data() + cabecalho.size();
+        RegistroCsv campo;
+        for (size_t i = 0; nomes.empty() || i < campo.numeroCampos; ++i) {
+            leRegistro(cabecalho.data(), fim, true, i, campo);
+            nomes.push_back(textoDoCampo(campo.chave, campo.tamanhoChave, campo.chaveComAspas));
+        }
+        for (size_t i = 0; i < nomes.size(); ++i) {
+            if (nomes[i] == coluna) {
+                indiceChave = i;
+                return;
+            }
+        }
+        if (!coluna.empty() && coluna.find_first_not_of("0123456789") == std::string::npos) {
+            indiceChave = std::stoull(coluna);
+            if (indiceChave >= nomes.size()) {
+                throw std::out_of_range("Índice da coluna " + coluna + " está fora do intervalo.");
+            }
+            return;
+        }
+        std::string lista;
+        for (const std::string& nome : nomes) {
+            lista += (lista.empty() ? "" : ", ") + nome;
+        }
+        throw std::invalid_argument("Coluna '" + coluna + "' não encontrada no cabeçalho: " + lista);
+    }
+
+    // Fase 1. Os registros são lidos para o buffer de dados e indexados até que dados e
+    // índice ocupem o orçamento; então o índice é ordenado e o run é gravado, e os bytes
+    // lidos que ainda não foram indexados passam para o começo do buffer.
+    std::vector<std::string> divideEmRuns(PastaTemporaria& pasta) {
+        std::FILE* arquivo = std::fopen(entrada.c_str(), "rb");
+        if (arquivo == nullptr) {
+            throw std::runtime_error("Arquivo de entrada não encontrado: " + entrada);
+        }
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> fechaArquivo(arquivo, std::fclose);
+        posix_fadvise(fileno(arquivo), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        size_t capacidade = orcamento;
+        std::unique_ptr<char[]> dados(new char[capacidade]);  // sem inicialização: só as páginas usadas
+        std::vector<char> chavesSeparadas;
+        std::vector<EntradaIndice> indice;
+        std::vector<std::string> runs;
+        size_t usados = 0;
+        size_t posicao = 0;
+        bool fimDoArquivo = false;
+        bool leuCabecalho = false;
+
+        while (true) {
+            bool cheio = false;
+            RegistroCsv registro;
+            while (true) {
+                if (!indice.empty() &&
+                    posicao + indice.size() * sizeof(EntradaIndice) + chavesSeparadas.size() >= orcamento) {
+                    cheio = true;
+                    break;
+                }
+                if (posicao == usados ||
+                    !leRegistro(dados.get() + posicao, dados.get() + usados, fimDoArquivo, indiceChave, registro)) {
+                    break;
+                }
+                const char* linha = dados.get() + posicao;
+                if (!leuCabecalho) {
+                    leuCabecalho = true;
+                    cabecalho.assign(linha, registro.tamanhoLinha);
+                    terminador = registro.proximo - linha == static_cast<ptrdiff_t>(registro.tamanhoLinha + 2) ? "\r\n" : "\n";
+                    defineColuna();
+                } else if (registro.tamanhoLinha > 0) {  // linhas em branco são ignoradas
+                    indexa(registro, linha, dados.get(), chavesSeparadas, indice);
+                }
+                posicao = static_cast<size_t>(registro.proximo - dados.get());
+            }
+
+            bool acabou = fimDoArquivo && posicao == usados;
+            if (cheio || acabou || (usados == capacidade && !indice.empty())) {
+                if (!indice.empty()) {
+                    runs.push_back(pasta.novoRun());
+                    gravaRun(dados.get(), chavesSeparadas, indice, runs.back());
+                    std::cout << "  Run #" << runs.size() - 1 << ": " << indice.size() << " registros" << std::endl;
+                    indice.clear();
+                    chavesSeparadas.clear();
+                }
+                std::memmove(dados.get(), dados.get() + posicao, usados - posicao);
+                usados -= posicao;
+                posicao = 0;
+                if (acabou) {
+                    break;
+                }
+                continue;
+            }
+            if (usados == capacidade) {
+                throw std::runtime_error("registro maior que o buffer de " + std::to_string(orcamento >> 20) + " MB");
+            }
+            size_t lidos = std::fread(dados.get() + usados, 1, std::min(BLOCO_LEITURA, capacidade - usados), arquivo);
+            if (lidos == 0) {
+                if (std::ferror(arquivo)) {
+                    throw std::runtime_error("erro de leitura em " + entrada);
+                }
+                fimDoArquivo = true;
+            }
+            usados += lidos;
+        }
+        return runs;
+    }
+
+    void indexa(const RegistroCsv& registro, const char* linha, const char* dados, std::vector<char>& chavesSeparadas,
+                std::vector<EntradaIndice>& indice) {
+        if (registro.chave == nullptr) {
+            throw std::runtime_error("registro " + std::to_string(linhas + 1) + " não tem a coluna " + coluna);
+        }
+        if (registro.tamanhoLinha > UINT32_MAX) {
+            throw std::runtime_error("registro " + std::to_string(linhas + 1) + " com mais de 4 GB");
+        }
+        EntradaIndice entrada;
+        entrada.linha = static_cast<uint64_t>(linha - dados);
+        entrada.tamanhoLinha = static_cast<uint32_t>(registro.tamanhoLinha);
+        entrada.chaveSeparada = registro.chaveComAspas;
+        Chave chave;
+        if (registro.chaveComAspas) {
+            std::string texto = textoDoCampo(registro.chave, registro.tamanhoChave, true);
+            entrada.chave = chavesSeparadas.size();
+            chavesSeparadas.insert(chavesSeparadas.end(), texto.begin(), texto.end());
+            converteChave(texto.data(), texto.size(), chave);
+        } else {
+            entrada.chave = static_cast<uint64_t>(registro.chave - dados);
+            converteChave(registro.chave, registro.tamanhoChave, chave);
+        }
+        entrada.tipo = chave.tipo;
+        entrada.tamanhoChave = chave.tamanho;
+        if (chave.tipo == INTEIRO) {
+            entrada.inteiro = chave.inteiro;
+        } else {
+            entrada.real = chave.tipo == REAL ? chave.real : 0.0;
+        }
+        indice.push_back(entrada);
+        ++linhas;
+    }
+
+    static Chave chaveDe(const EntradaIndice& entrada, const char* dados, const std::vector<char>& chavesSeparadas) {
+        Chave chave;
+        chave.tipo = entrada.tipo;
+        if (entrada.tipo == INTEIRO) {
+            chave.inteiro = entrada.inteiro;
+        } else {
+            chave.real = entrada.real;
+        }
+        chave.texto = (entrada.chaveSeparada ? chavesSeparadas.data() : dados) + entrada.chave;
+        chave.tamanho = entrada.tamanhoChave;
+        return chave;
+    }
+
+    void gravaRun(const char* dados, const std::vector<char>& chavesSeparadas, std::vector<EntradaIndice>& indice,
+                  const std::string& caminho) {
+        bool desc = descendente;
+        // A posição da linha desempata: chaves iguais ficam na ordem da entrada (estável)
+        std::sort(indice.begin(), indice.end(), [&](const EntradaIndice& a, const EntradaIndice& b) {
+            int c = comparaChaves(chaveDe(a, dados, chavesSeparadas), chaveDe(b, dados, chavesSeparadas));
+            if (desc) {
+                c = -c;
+            }
+            return c < 0 || (c == 0 && a.linha < b.linha);
+        });
+        Escritor saida(caminho, BUFFER_SAIDA);
+        for (const EntradaIndice& entrada : indice) {
+            gravaRegistro(saida, chaveDe(entrada, dados, chavesSeparadas), dados + entrada.linha, entrada.tamanhoLinha);
+        }
+        saida.fechar();
+    }
+
+    // Intercala os runs em 'destino': como CSV (com o cabeçalho) no final, ou como outro
+    // run binário nas mesclas intermediárias.
+    void mescla(const std::vector<std::string>& caminhos, const std::string& destino, bool csv) {
+        size_t bufferPorRun = std::max(orcamento / (caminhos.size() + 1), BUFFER_MINIMO_RUN);
+        std::vector<std::unique_ptr<LeitorRun>> runs;
+        for (const std::string& caminho : caminhos) {
+            runs.emplace_back(new LeitorRun(caminho, bufferPorRun));
+        }
+        Escritor saida(destino, BUFFER_SAIDA);
+        if (csv) {
+            saida.escrever(cabecalho.data(), cabecalho.size());
+            saida.escrever(terminador.data(), terminador.size());
+        }
+        ArvorePerdedores arvore(runs, descendente);
+        while (!arvore.vazia()) {
+            LeitorRun& run = arvore.vencedor();
+            if (csv) {
+                saida.escrever(run.linha, run.tamanhoLinha);
+                saida.escrever(terminador.data(), terminador.size());
+            } else {
+                gravaRegistro(saida, run.chave, run.linha, run.tamanhoLinha);
+            }
+            arvore.avancar();
+        }
+        saida.fechar();
+    }
+};
+
+// <base>_ordenado<extensão>, como os.path.splitext na versão em Python.
+std::string caminhoDeSaida(const std::string& entrada) {
+    size_t barra = entrada.find_last_of('/');
+    size_t inicioNome = barra == std::string::npos ? 0 : barra + 1;
+    size_t ponto = entrada.find_last_of('.');
+    if (ponto == std::string::npos || ponto < inicioNome ||
+        entrada.find_first_not_of('.', inicioNome) > ponto) {  // ".csv" não tem extensão
+        return entrada + "_ordenado";
+    }
+    return entrada.substr(0, ponto) + "_ordenado" + entrada.substr(ponto);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 5) {
+        std::cerr << "Uso: " << argv[0] << " <entrada.csv> <coluna> [ascendente|descendente] [tamanho_buffer_mb]\n"
+                  << "  coluna: nome da coluna no cabeçalho ou índice (a partir de 0)\n"
+                  << "  padrão: ascendente, 100 MB" << std::endl;
+        return 1;
+    }
+    std::string entrada = argv[1];
+    std::string ordem = argc > 3 ? argv[3] : "ascendente";
+    for (char& c : ordem) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (ordem != "ascendente" && ordem != "descendente") {
+        std::cerr << "Erro: ordem deve ser 'ascendente' ou 'descendente'." << std::endl;
+        return 1;
+    }
+    size_t bufferMb = 100;
+    if (argc > 4) {
+        char* fim = nullptr;
+        bufferMb = std::strtoull(argv[4], &fim, 10);
+        if (*fim != '\0' || bufferMb == 0) {
+            std::cerr << "Erro: tamanho_buffer_mb deve ser um inteiro positivo." << std::endl;
+            return 1;
+        }
+    }
+    if (access(entrada.c_str(), R_OK) != 0) {
+        std::cerr << "Erro: Arquivo de entrada '" << entrada << "' não encontrado." << std::endl;
+        return 1;
+    }
+
+    std::string saida = caminhoDeSaida(entrada);
+    try {
+        OrdenacaoExterna ordenacao(entrada, argv[2], ordem == "descendente", bufferMb);
+        if (!ordenacao.ordenar(saida)) {
+            std::cout << "Arquivo de entrada está vazio ou contém apenas o cabeçalho." << std::endl;
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "\n--- Ordenação Concluída ---\nArquivo final ordenado salvo em: " << saida << std::endl;
+    return 0;
+}